@@ -0,0 +1,64 @@
+#ifndef CANAL_VALIDACAO_H
+#define CANAL_VALIDACAO_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include "tabuleiro.h"
+
+// Estado de um pedido VALIDAR_TABULEIRO, escrito pela thread de E/S
+typedef enum
+{
+    VALIDACAO_NENHUMA = 0,   // Conclusão ainda não usada
+    VALIDACAO_PENDENTE = 1,
+    VALIDACAO_OK = 2,        // O servidor confirmou todas as unidades pedidas
+    VALIDACAO_NOK = 3,       // Pelo menos uma unidade tem um valor errado
+    VALIDACAO_CANCELADA = 4  // Não enviado ou sem resposta (fim do jogo, ligação perdida)
+} EstadoValidacao;
+
+// Conclusão de um pedido: pertence a quem submete, que a consulta quando
+// quiser (nunca espera por ela). Não pode ser reutilizada nem libertada
+// enquanto estiver VALIDACAO_PENDENTE. unidades e veredicto (máscaras
+// UNIDADE_* do protocolo) só são válidos depois de o estado sair de PENDENTE.
+typedef struct
+{
+    atomic_int estado;  // EstadoValidacao
+    uint32_t unidades;  // Unidades pedidas
+    uint32_t veredicto; // Unidades que o servidor deu como corretas
+} ConclusaoValidacao;
+
+// Canal assíncrono de validação parcial: as threads do solver submetem
+// pedidos numa fila sem locks e continuam a pesquisa; uma thread de E/S
+// dedicada envia-os seguidos pelo socket, associa as respostas (por ordem
+// de envio, a ordem em que o servidor responde) e preenche as conclusões.
+typedef struct CanalValidacao CanalValidacao;
+
+// Chamada pela thread de E/S quando o servidor responde JOGO_TERMINADO
+typedef void (*CallbackJogoTerminado)(void *arg, int vencedor);
+
+// Chamada pela thread de E/S quando o servidor recusa unidades (NOK),
+// antes de concluir o pedido, com o tabuleiro que foi enviado
+typedef void (*CallbackUnidadesRecusadas)(void *arg, const Tabuleiro *tabuleiro, uint32_t recusadas);
+
+// Cria o canal e a sua thread de E/S (parada até ao primeiro jogo). Os
+// callbacks são opcionais. Devolve NULL em caso de erro.
+CanalValidacao *canal_validacao_criar(CallbackJogoTerminado jogo_terminado,
+                                      CallbackUnidadesRecusadas unidades_recusadas, void *arg);
+
+void canal_validacao_destruir(CanalValidacao *canal);
+
+// Começa a aceitar pedidos para um jogo neste socket
+void canal_validacao_iniciar_jogo(CanalValidacao *canal, int sockfd, int idCliente);
+
+// Submete sem bloquear a validação das unidades indicadas (blocos, linhas
+// e colunas, máscara UNIDADE_*) de um tabuleiro parcial 9x9, num único
+// VALIDAR_TABULEIRO. Devolve 0 (e não toca na conclusão) se o canal não
+// estiver ativo ou a fila estiver cheia.
+int canal_validacao_submeter(CanalValidacao *canal, const Tabuleiro *tabuleiro, uint32_t unidades,
+                             int thread_id, ConclusaoValidacao *conclusao);
+
+// Deixa de aceitar pedidos, cancela os que ainda não foram enviados e
+// espera pelas respostas dos enviados: a seguir o socket volta a ser só
+// de quem chama. Chamar depois de as threads que submetem pararem.
+void canal_validacao_terminar_jogo(CanalValidacao *canal);
+
+#endif
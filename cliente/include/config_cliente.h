@@ -1,6 +1,8 @@
 #ifndef CONFIG_CLIENTE_H
 #define CONFIG_CLIENTE_H
 
+#include "solver.h"
+
 typedef struct {
     char ipServidor[50];   // Espaço para um endereço IP (ex: 192.168.1.100)
     int idCliente;         // ID deste cliente
@@ -8,6 +10,15 @@ typedef struct {
     int timeoutServidor;   // Timeout para operações de socket com servidor (segundos)
     char ficheiroLog[100]; // Opcional: para o cliente também ter um log
     int numThreads;        // Número de threads para resolução paralela (1-9)
+    HeuristicaCelula heuristica; // Escolha da célula a ramificar (PRIMEIRA ou MRV)
+    int propagacao;        // 1 = deduzir naked/hidden singles após cada colocação
+    MotorSolver motor;     // Motor de resolução (BACKTRACKING, DLX, BITBOARD, PORTFOLIO ou SAT)
+    int bitsTransposicao;  // Tabela de transposição com 2^bits entradas (0 = desligada)
+    unsigned int semente;  // != 0: pesquisa paralela determinística com esta semente
+    int oraculo;           // 1 = cortar a pesquisa com as unidades recusadas pelo servidor
+    ModoRitmo ritmo;       // Pausas de apresentação (DESLIGADO, FIXO ou LIMITADO)
+    int ritmoAtrasoMs;     // FIXO: pausa por evento (ms)
+    int ritmoPorSegundo;   // LIMITADO: máximo de eventos por segundo
 } ConfigCliente;
 
 int lerConfigCliente(const char *nomeFicheiro, ConfigCliente *config);
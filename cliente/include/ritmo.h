@@ -0,0 +1,28 @@
+#ifndef RITMO_H
+#define RITMO_H
+
+#include <stdatomic.h>
+
+// Ritmo artificial da resolução, para apresentações (RITMO no cliente.conf)
+typedef enum
+{
+    RITMO_DESLIGADO = 0, // Sem pausas (bots, benchmarks)
+    RITMO_FIXO = 1,      // Pausa fixa em cada evento
+    RITMO_LIMITADO = 2   // No máximo N eventos por segundo, somando todas as threads
+} ModoRitmo;
+
+typedef struct Ritmo Ritmo;
+
+// Cria o controlador de ritmo. Com RITMO_DESLIGADO devolve NULL: quem o
+// usa guarda o ponteiro e, sem ritmo, nunca chega a chamar ritmo_aguardar.
+// atraso_ms é usado no modo FIXO, por_segundo no LIMITADO.
+Ritmo *ritmo_criar(ModoRitmo modo, int atraso_ms, int por_segundo);
+
+void ritmo_destruir(Ritmo *ritmo);
+
+// Pausa antes do próximo evento (arranque de uma thread, validação de um
+// bloco). Acorda mais cedo se *parar ficar != 0 (parar pode ser NULL).
+// Seguro de várias threads.
+void ritmo_aguardar(Ritmo *ritmo, const atomic_int *parar);
+
+#endif
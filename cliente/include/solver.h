@@ -2,25 +2,178 @@
 #define SOLVER_H
 
 #include <pthread.h>
+#include <stdatomic.h>
+#include "tabuleiro.h"
+#include "motor_sudoku.h"
+#include "tabuleiro_nxn.h"
+#include "canal_validacao.h"
+#include "ritmo.h"
+#include "protocolo.h"
+
+// Motor usado por resolver_sudoku
+typedef enum
+{
+    MOTOR_BACKTRACKING = 0, // Backtracking paralelo com validação remota
+    MOTOR_DLX = 1,          // Dancing Links (Algoritmo X), sequencial
+    MOTOR_BITBOARD = 2,     // Bitboards de dígitos com SIMD (SSE2/AVX2), sequencial
+    MOTOR_PORTFOLIO = 3,    // Várias estratégias em corrida; ganha a primeira a resolver
+    MOTOR_SAT = 4           // Codificação SAT com solver CDCL, sequencial
+} MotorSolver;
+
+// Limite de threads do solver paralelo (NUM_THREADS: 0 = uma por core)
+#define MAX_THREADS_SOLVER 64
+
+// Motivo pelo qual uma resolução parou
+typedef enum
+{
+    PARAGEM_NENHUMA = 0,       // Espaço de busca esgotado sem solução
+    PARAGEM_SOLUCAO = 1,       // Uma thread encontrou a solução
+    PARAGEM_CANCELADO = 2,     // solver_contexto_cancelar() chamado
+    PARAGEM_PRAZO = 3,         // Prazo da resolução ultrapassado
+    PARAGEM_JOGO_TERMINADO = 4 // Servidor respondeu JOGO_TERMINADO a uma validação
+} MotivoParagem;
+
+// Estado completo de uma resolução paralela (pool de threads, tarefas,
+// solução e flag de paragem). Opaco: definido em solver.c.
+typedef struct SolverContext SolverContext;
+
+// Tarefa do work-stealing: uma subárvore por explorar
+typedef struct
+{
+    Tabuleiro tabuleiro;  // Tabuleiro antes da colocação (81 bytes)
+    int linha;            // Célula onde colocar o número
+    int coluna;
+    int numero;           // Número a testar nessa célula
+    int bandas_validadas; // Bandas já validadas no caminho até aqui
+} Tarefa;
 
 // Estrutura para passar argumentos às threads
 typedef struct
 {
-    int id;              // ID da thread para debug
-    int tabuleiro[9][9]; // Cópia local do tabuleiro
-    int linha_inicial;   // Linha da célula de arranque
-    int coluna_inicial;  // Coluna da célula de arranque
-    int numero_arranque; // Número a testar nessa célula
-    int sockfd;          // Socket para validação remota
-    int idCliente;       // ID do cliente para protocolo
+    SolverContext *ctx;      // Contexto a que a thread pertence
+    int id;                  // ID da thread (e da sua deque de tarefas)
+    int sockfd;              // Socket para validação remota
+    int idCliente;           // ID do cliente para protocolo
+    int num_trabalhadores;   // Total de threads (vítimas possíveis de roubo)
+    long tarefas_executadas; // Estatísticas para o log
+    long tarefas_roubadas;
+    long nos;                // Nós visitados (para verificar o prazo)
+    long tt_acertos;         // Consultas à tabela de transposição neste jogo
+    long tt_falhas;
+    const atomic_int *cancelar; // Paragem externa quando não há contexto (portfolio)
+    int tarefa_atual;           // Índice da tarefa em curso (modo determinístico)
+    ConclusaoValidacao validacoes[3];            // Última validação remota de cada banda
+    uint64_t chaves_validadas[NUM_UNIDADES];     // Conteúdo (chave_unidade) do último pedido de cada unidade
+    long podas_oraculo;                          // Subárvores cortadas por unidades recusadas pelo servidor
 } ThreadArgs;
 
-int resolver_sudoku(char *tabuleiro, int sockfd, int idCliente);
+int resolver_sudoku(Tabuleiro *tabuleiro, int sockfd, int idCliente);
+
+// Segunda tentativa quando a solução de resolver_sudoku falha a
+// verificação local: resolve de novo o puzzle com um motor sequencial
+// diferente do configurado (DLX, ou Bitboard se o motor já for DLX), sem
+// falar com o servidor. Em *motor fica o nome do motor usado.
+int resolver_sudoku_recurso(Tabuleiro *tabuleiro, const char **motor);
+
+// 16x16 e 25x25 (bloco 4 ou 5): sequencial e sem validação remota. Com
+// MOTOR SAT usa o solver CDCL, com os restantes o núcleo N×N de common/
+int resolver_sudoku_nxn(TabuleiroNxN *tabuleiro, int bloco);
+
+// resolver_sudoku_recurso para 16x16 e 25x25: o outro motor N×N (CDCL,
+// ou o núcleo N×N se o motor configurado for SAT)
+int resolver_sudoku_nxn_recurso(TabuleiroNxN *tabuleiro, int bloco, const char **motor);
+
+// Resultado agregado de resolver_sudoku_lote
+typedef struct
+{
+    int total;                  // Tabuleiros recebidos
+    int resolvidos;             // Tabuleiros com solução encontrada
+    int threads;                // Threads efetivamente usadas
+    double segundos;            // Tempo de parede do lote
+    double puzzles_por_segundo; // Débito agregado (total / segundos)
+} EstatisticasLote;
+
+// Resolve n tabuleiros independentes, no próprio array, intercalando
+// várias pesquisas por thread (backtracking com propagação, sem servidor).
+// resultados[i] (opcional) fica a 1 se o tabuleiro i foi resolvido.
+// numThreads = 0 usa uma thread por core. Devolve o número de resolvidos.
+int resolver_sudoku_lote(Tabuleiro *tabuleiros, int *resultados, int n, int numThreads, EstatisticasLote *estatisticas);
+
+// Pesquisas avançadas à vez por cada thread de resolver_sudoku_lote (1-16)
+void set_global_lote_intercalados(int n);
+
+// Portfolio: corre em simultâneo backtracking MRV com propagação, DLX,
+// bitboards, backtracking com reinícios aleatórios e CDCL, fica com a
+// primeira resposta e cancela as restantes. A resposta é uma solução ou a
+// prova de que não há nenhuma (um membro completo esgotou a pesquisa, e
+// então devolve 0). Sem validação remota. vencedor (opcional) recebe o
+// nome da estratégia que respondeu.
+int resolver_sudoku_portfolio(Tabuleiro *tabuleiro, const char **vencedor);
 
-int resolver_sudoku_paralelo(int tabuleiro_inicial[9][9], int sockfd, int idCliente, int numThreads);
+// Contextos de resolução: cada um tem o seu pool de threads e pode
+// resolver em simultâneo com os outros
+SolverContext *solver_contexto_criar(int numThreads);
+
+void solver_contexto_destruir(SolverContext *ctx);
+
+// Pede a paragem imediata da resolução em curso (seguro de qualquer thread)
+void solver_contexto_cancelar(SolverContext *ctx);
+
+// Prazo para as próximas resoluções, em segundos (0 = sem prazo)
+void solver_contexto_definir_prazo(SolverContext *ctx, double segundos);
+
+// Semente != 0 liga o modo determinístico: tarefas fixas tiradas por ordem,
+// sem work-stealing nem tabela de transposição. A mesma semente dá a mesma
+// solução e o mesmo número de nós em todas as execuções, com qualquer
+// número de threads (0 = desligado).
+void solver_contexto_definir_semente(SolverContext *ctx, unsigned int semente);
+
+MotivoParagem solver_contexto_motivo(const SolverContext *ctx);
+
+// Cliente vencedor indicado pelo servidor (se o motivo for PARAGEM_JOGO_TERMINADO)
+int solver_contexto_vencedor(const SolverContext *ctx);
+
+int resolver_sudoku_paralelo(SolverContext *ctx, Tabuleiro *tabuleiro_inicial, int sockfd, int idCliente);
+
+// Resolve na thread que chama, sem pool nem rede (ferramentas offline).
+// Reentrante: várias threads podem chamá-la ao mesmo tempo.
+int resolver_sudoku_sequencial(Tabuleiro *tabuleiro);
 
 int get_num_threads_last_run();
 
+// Pool persistente de threads do solver paralelo (reutilizado entre jogos)
+int iniciar_pool_solver(int numThreads);
+
+void terminar_pool_solver(void);
+
+// Contexto usado pelo resolver_sudoku() (NULL se o pool não foi iniciado)
+SolverContext *solver_contexto_global(void);
+
 void set_global_num_threads(int num);
 
+void set_global_heuristica(HeuristicaCelula heuristica);
+
+void set_global_propagacao(int ativa);
+
+void set_global_motor(MotorSolver motor);
+
+// Tabela de transposição dos contextos criados a seguir: 2^bits entradas
+// de 8 bytes (0 = desligada). Chamar antes de iniciar_pool_solver().
+void set_global_tabela_transposicao(int bits);
+
+// Semente dos contextos criados a seguir (ver solver_contexto_definir_semente)
+// e dos reinícios aleatórios do portfolio. Chamar antes de iniciar_pool_solver().
+void set_global_semente(unsigned int semente);
+
+// Oráculo: com 1, os blocos que o servidor recusa (NOK) cortam a pesquisa
+// de todas as threads que os tenham completos, e cada banda volta a ser
+// validada sempre que fica completa com outro conteúdo. Ignorado no modo
+// determinístico. Chamar antes de iniciar_pool_solver().
+void set_global_oraculo(int ativo);
+
+// Ritmo de apresentação dos contextos criados a seguir: pausas no arranque
+// de cada thread e em cada validação remota (RITMO_DESLIGADO = nenhuma).
+// Chamar antes de iniciar_pool_solver().
+void set_global_ritmo(ModoRitmo modo, int atraso_ms, int por_segundo);
+
 #endif
@@ -0,0 +1,20 @@
+#ifndef SOLVER_BITBOARD_H
+#define SOLVER_BITBOARD_H
+
+#include <stdatomic.h>
+#include "tabuleiro.h"
+
+// Resolve o tabuleiro (0 = célula vazia) com bitboards de dígitos
+// (um registo de 128 bits por dígito). Usa AVX2 ou SSE2 quando o CPU
+// suporta, senão a versão escalar. Devolve 1 e preenche o tabuleiro
+// se houver solução, 0 caso contrário.
+int resolver_sudoku_bitboard(Tabuleiro *tabuleiro);
+
+// Igual a resolver_sudoku_bitboard, mas abandona a pesquisa (devolve 0)
+// assim que *parar fica != 0
+int resolver_sudoku_bitboard_cancelavel(Tabuleiro *tabuleiro, const atomic_int *parar);
+
+// Nome do kernel escolhido em runtime ("AVX2", "SSE2" ou "escalar")
+const char *bitboard_kernel_ativo(void);
+
+#endif
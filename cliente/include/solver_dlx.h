@@ -0,0 +1,17 @@
+#ifndef SOLVER_DLX_H
+#define SOLVER_DLX_H
+
+#include <stdatomic.h>
+#include "tabuleiro.h"
+
+// Resolve o tabuleiro (0 = célula vazia) por cobertura exata com Dancing Links.
+// A matriz de 324 colunas é construída uma vez; cada thread resolve numa
+// cópia sua (cerca de 79 KB), reutilizada entre jogos. Reentrante.
+// Devolve 1 e preenche o tabuleiro se houver solução, 0 caso contrário.
+int resolver_sudoku_dlx(Tabuleiro *tabuleiro);
+
+// Igual a resolver_sudoku_dlx, mas abandona a pesquisa (devolve 0) assim
+// que *parar fica != 0. A matriz volta sempre ao estado inicial.
+int resolver_sudoku_dlx_cancelavel(Tabuleiro *tabuleiro, const atomic_int *parar);
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef SOLVER_SAT_H
+#define SOLVER_SAT_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include "tabuleiro.h"
+
+// Contadores de uma resolução CDCL
+typedef struct
+{
+    int variaveis;       // Variáveis (célula, dígito) por decidir após as pistas
+    int clausulas;       // Cláusulas originais da codificação
+    long decisoes;
+    long propagacoes;
+    long conflitos;
+    long reinicios;
+    long aprendidas;     // Cláusulas aprendidas (inclui as já apagadas)
+} EstatisticasSat;
+
+// Resolve o tabuleiro (0 = célula vazia) codificando-o em SAT e usando um
+// solver CDCL (watched literals, VSIDS, reinícios de Luby). Devolve 1 e
+// preenche o tabuleiro se houver solução, 0 caso contrário.
+int resolver_sudoku_sat(Tabuleiro *tabuleiro);
+
+// Igual a resolver_sudoku_sat, mas abandona a pesquisa (devolve 0) assim
+// que *parar fica != 0
+int resolver_sudoku_sat_cancelavel(Tabuleiro *tabuleiro, const atomic_int *parar);
+
+// Núcleo para qualquer tamanho: 'celulas' tem lado² valores (lado =
+// bloco², bloco 3-5) por ordem de linhas. 'parar' e 'estatisticas' são
+// opcionais.
+int resolver_grelha_sat(uint8_t *celulas, int bloco, const atomic_int *parar, EstatisticasSat *estatisticas);
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef TRANSPOSICAO_H
+#define TRANSPOSICAO_H
+
+#include <stdint.h>
+
+// Tabela de transposição de posições refutadas: tabuleiros (parciais) que
+// já se provou não terem solução. Partilhada pelas threads de um contexto
+// sem locks; cada entrada guarda a chave Zobrist completa (64 bits).
+typedef struct TabelaTransposicao TabelaTransposicao;
+
+// Chave Zobrist do número 'num' (1-9) na posição 'pos' (0-80). A chave de
+// um tabuleiro é o XOR das chaves das células preenchidas, pelo que pode
+// ser mantida incrementalmente ao colocar/retirar números.
+// Calculada (splitmix64) em vez de lida de uma tabela: não precisa de
+// inicialização e não ocupa cache.
+static inline uint64_t zobrist_chave(int pos, int num)
+{
+    uint64_t z = (uint64_t)(pos * 10 + num + 1) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Cria uma tabela com 2^bits entradas (8 bytes cada). bits <= 0 devolve
+// NULL (tabela desligada); bits acima de 30 são limitados a 30.
+TabelaTransposicao *transposicao_criar(int bits);
+
+void transposicao_destruir(TabelaTransposicao *tt);
+
+// 1 se a posição com esta chave foi registada como refutada
+int transposicao_contem(const TabelaTransposicao *tt, uint64_t chave);
+
+// Regista uma posição refutada (substitui o que estiver na entrada)
+void transposicao_registar(TabelaTransposicao *tt, uint64_t chave);
+
+// Entradas totais e entradas já usadas (para dimensionar a tabela)
+long transposicao_capacidade(const TabelaTransposicao *tt);
+long transposicao_ocupadas(const TabelaTransposicao *tt);
+
+#endif
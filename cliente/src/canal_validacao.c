@@ -0,0 +1,446 @@
+// cliente/src/canal_validacao.c - Validação remota parcial assíncrona
+//
+// Fila de submissão: buffer circular limitado sem locks (sequência por
+// célula, à Vyukov). Vários produtores (threads do solver) reservam uma
+// posição com CAS na cauda; o único consumidor (thread de E/S) lê a cabeça.
+// Submeter nunca bloqueia: com a fila cheia o pedido é recusado.
+//
+// A thread de E/S acorda por um pipe não bloqueante (um byte por pedido),
+// envia seguidos todos os pedidos da fila e só lê do socket enquanto há
+// pedidos em voo. O servidor trata as mensagens de um cliente por ordem,
+// pelo que a resposta que chega é sempre a do pedido em voo mais antigo.
+// Um JOGO_TERMINADO cancela os pedidos em voo (o servidor fecha a ligação
+// a seguir) e todos os que ainda chegarem nesse jogo.
+//
+// Cada pedido é um VALIDAR_TABULEIRO com o tabuleiro parcial e a máscara
+// de unidades: uma banda completa (3 blocos, 3 linhas e as colunas que já
+// estiverem cheias) custa uma ida ao servidor em vez de três.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <sys/socket.h>
+#include "canal_validacao.h"
+#include "logs_cliente.h"
+#include "protocolo.h"
+#include "util.h"
+
+// Potência de 2; também é o máximo de pedidos em voo
+#define CAPACIDADE_FILA 64
+
+typedef struct
+{
+    Tabuleiro tabuleiro;
+    uint32_t unidades;
+    int thread_id;
+    ConclusaoValidacao *conclusao;
+} PedidoValidacao;
+
+typedef struct
+{
+    atomic_size_t sequencia; // == posição: livre; == posição + 1: com pedido
+    PedidoValidacao pedido;
+} CelulaFila;
+
+struct CanalValidacao
+{
+    // Fila de submissão (produtores: threads do solver)
+    CelulaFila fila[CAPACIDADE_FILA];
+    atomic_size_t cauda;
+    size_t cabeca; // Só a thread de E/S mexe
+
+    atomic_int ativo; // Aceita pedidos (entre iniciar_jogo e terminar_jogo)
+    int pipe_acordar[2];
+
+    // Estado do jogo, só da thread de E/S
+    int sockfd;
+    int idCliente;
+    int ligacao_perdida; // JOGO_TERMINADO ou erro: não enviar mais nada
+    PedidoValidacao em_voo[CAPACIDADE_FILA];
+    int inicio_voo;
+    int num_voo;
+
+    // Estatísticas do jogo (lidas depois de drenado)
+    int enviados;
+    int respostas_ok;
+    int respostas_nok;
+    int cancelados;
+    int max_em_voo;
+
+    CallbackJogoTerminado jogo_terminado;
+    CallbackUnidadesRecusadas unidades_recusadas;
+    void *arg_callbacks;
+
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t mudou; // Início de jogo, fim de jogo ou canal drenado
+    int em_jogo;          // Há um jogo a decorrer (sockfd válido)
+    int drenado;          // Sem pedidos na fila nem em voo depois de terminar
+    int a_terminar;
+};
+
+static void acordar(CanalValidacao *canal)
+{
+    char c = 0;
+    // Pipe cheio: a thread já tem bytes por ler, logo vai acordar
+    if (write(canal->pipe_acordar[1], &c, 1) < 0 && errno != EAGAIN)
+        perror("canal_validacao: write");
+}
+
+static int fila_retirar(CanalValidacao *canal, PedidoValidacao *pedido)
+{
+    CelulaFila *celula = &canal->fila[canal->cabeca & (CAPACIDADE_FILA - 1)];
+    size_t seq = atomic_load_explicit(&celula->sequencia, memory_order_acquire);
+
+    if (seq != canal->cabeca + 1)
+        return 0;
+    *pedido = celula->pedido;
+    atomic_store_explicit(&celula->sequencia, canal->cabeca + CAPACIDADE_FILA, memory_order_release);
+    canal->cabeca++;
+    return 1;
+}
+
+static void concluir(CanalValidacao *canal, const PedidoValidacao *pedido, EstadoValidacao estado, uint32_t veredicto)
+{
+    if (estado == VALIDACAO_OK)
+        canal->respostas_ok++;
+    else if (estado == VALIDACAO_NOK)
+        canal->respostas_nok++;
+    else
+        canal->cancelados++;
+    pedido->conclusao->veredicto = veredicto;
+    atomic_store_explicit(&pedido->conclusao->estado, (int)estado, memory_order_release);
+}
+
+static void cancelar_em_voo(CanalValidacao *canal)
+{
+    while (canal->num_voo > 0)
+    {
+        concluir(canal, &canal->em_voo[canal->inicio_voo], VALIDACAO_CANCELADA, 0);
+        canal->inicio_voo = (canal->inicio_voo + 1) % CAPACIDADE_FILA;
+        canal->num_voo--;
+    }
+}
+
+// send com MSG_NOSIGNAL: um servidor que já fechou a ligação não pode
+// matar o cliente com SIGPIPE a meio de uma rajada de pedidos
+static int enviar_tudo(int sockfd, const void *dados, size_t n)
+{
+    const char *p = dados;
+    while (n > 0)
+    {
+        ssize_t enviados = send(sockfd, p, n, MSG_NOSIGNAL);
+        if (enviados < 0 && errno == EINTR)
+            continue;
+        if (enviados <= 0)
+            return 0;
+        p += enviados;
+        n -= (size_t)enviados;
+    }
+    return 1;
+}
+
+// Envia os pedidos da fila enquanto houver espaço para mais em voo
+static void enviar_pendentes(CanalValidacao *canal)
+{
+    PedidoValidacao pedido;
+
+    while (canal->num_voo < CAPACIDADE_FILA && fila_retirar(canal, &pedido))
+    {
+        if (canal->ligacao_perdida)
+        {
+            concluir(canal, &pedido, VALIDACAO_CANCELADA, 0);
+            continue;
+        }
+
+        MensagemSudoku msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.tipo = VALIDAR_TABULEIRO;
+        msg.idCliente = canal->idCliente;
+        msg.unidades = pedido.unidades;
+        tabuleiro_compactar(&pedido.tabuleiro, &msg.tabuleiro);
+
+        if (!enviar_tudo(canal->sockfd, &msg, sizeof(msg)))
+        {
+            registarEventoCliente(EVTC_ERRO, "[E/S] Erro ao enviar VALIDAR_TABULEIRO: validações canceladas neste jogo");
+            canal->ligacao_perdida = 1;
+            concluir(canal, &pedido, VALIDACAO_CANCELADA, 0);
+            cancelar_em_voo(canal);
+            continue;
+        }
+
+        canal->em_voo[(canal->inicio_voo + canal->num_voo) % CAPACIDADE_FILA] = pedido;
+        canal->num_voo++;
+        canal->enviados++;
+        if (canal->num_voo > canal->max_em_voo)
+            canal->max_em_voo = canal->num_voo;
+    }
+}
+
+// Lê uma resposta e conclui o pedido em voo mais antigo
+static void receber_resposta(CanalValidacao *canal)
+{
+    MensagemSudoku resp;
+    char log_msg[256];
+
+    if (readn(canal->sockfd, (char *)&resp, sizeof(resp)) != sizeof(resp))
+    {
+        registarEventoCliente(EVTC_ERRO, "[E/S] Ligação perdida à espera de RESPOSTA_TABULEIRO");
+        canal->ligacao_perdida = 1;
+        cancelar_em_voo(canal);
+        return;
+    }
+
+    if (resp.tipo == JOGO_TERMINADO)
+    {
+        // Outro cliente ganhou e o servidor fecha a ligação deste jogo
+        snprintf(log_msg, sizeof(log_msg), "[E/S] JOGO_TERMINADO recebido (Cliente %d venceu). %d validações em voo canceladas.",
+                 resp.idCliente, canal->num_voo);
+        registarEventoCliente(EVTC_ERRO, log_msg);
+        canal->ligacao_perdida = 1;
+        cancelar_em_voo(canal);
+        if (canal->jogo_terminado)
+            canal->jogo_terminado(canal->arg_callbacks, resp.idCliente);
+        return;
+    }
+
+    PedidoValidacao *pedido = &canal->em_voo[canal->inicio_voo];
+    canal->inicio_voo = (canal->inicio_voo + 1) % CAPACIDADE_FILA;
+    canal->num_voo--;
+
+    if (resp.tipo != RESPOSTA_TABULEIRO || resp.unidades != pedido->unidades)
+    {
+        snprintf(log_msg, sizeof(log_msg), "[E/S] Resposta inesperada (tipo %d, unidades 0x%07x) ao pedido 0x%07x",
+                 (int)resp.tipo, resp.unidades, pedido->unidades);
+        registarEventoCliente(EVTC_ERRO, log_msg);
+        concluir(canal, pedido, VALIDACAO_CANCELADA, 0);
+        return;
+    }
+
+    // O veredicto só pode confirmar unidades que foram pedidas
+    uint32_t veredicto = resp.veredicto & pedido->unidades;
+    uint32_t recusadas = pedido->unidades & ~veredicto;
+
+    snprintf(log_msg, sizeof(log_msg), "[E/S] Tabuleiro (Thread %d): %d/%d unidades corretas (%d em voo)",
+             pedido->thread_id, __builtin_popcount(veredicto), __builtin_popcount(pedido->unidades), canal->num_voo);
+    registarEventoCliente(EVTC_ERRO, log_msg);
+
+    if (recusadas && canal->unidades_recusadas)
+        canal->unidades_recusadas(canal->arg_callbacks, &pedido->tabuleiro, recusadas);
+    concluir(canal, pedido, recusadas ? VALIDACAO_NOK : VALIDACAO_OK, veredicto);
+}
+
+static void *thread_es(void *arg)
+{
+    CanalValidacao *canal = arg;
+
+    for (;;)
+    {
+        // Entre jogos o socket é de quem chama: esperar pelo próximo jogo
+        pthread_mutex_lock(&canal->mutex);
+        while (!canal->em_jogo && !canal->a_terminar)
+            pthread_cond_wait(&canal->mudou, &canal->mutex);
+        int sair = canal->a_terminar;
+        pthread_mutex_unlock(&canal->mutex);
+        if (sair)
+            break;
+
+        enviar_pendentes(canal);
+
+        // Fim do jogo pedido: quando nada ficar por enviar nem por receber,
+        // devolver o socket
+        if (!atomic_load(&canal->ativo) && canal->num_voo == 0)
+        {
+            PedidoValidacao resto;
+            while (fila_retirar(canal, &resto))
+                concluir(canal, &resto, VALIDACAO_CANCELADA, 0);
+
+            pthread_mutex_lock(&canal->mutex);
+            canal->em_jogo = 0;
+            canal->drenado = 1;
+            pthread_cond_broadcast(&canal->mudou);
+            pthread_mutex_unlock(&canal->mutex);
+            continue;
+        }
+
+        struct pollfd fds[2];
+        fds[0].fd = canal->pipe_acordar[0];
+        fds[0].events = POLLIN;
+        fds[1].fd = canal->sockfd;
+        fds[1].events = POLLIN;
+
+        // Só ler do socket com pedidos em voo (o resto é do str_cli)
+        int nfds = canal->num_voo > 0 ? 2 : 1;
+        if (poll(fds, nfds, -1) < 0)
+        {
+            if (errno != EINTR)
+                perror("canal_validacao: poll");
+            continue;
+        }
+
+        if (fds[0].revents & POLLIN)
+        {
+            char lixo[64];
+            while (read(canal->pipe_acordar[0], lixo, sizeof(lixo)) > 0)
+                ;
+        }
+        if (nfds == 2 && (fds[1].revents & (POLLIN | POLLHUP | POLLERR)))
+            receber_resposta(canal);
+    }
+
+    return NULL;
+}
+
+CanalValidacao *canal_validacao_criar(CallbackJogoTerminado jogo_terminado,
+                                      CallbackUnidadesRecusadas unidades_recusadas, void *arg)
+{
+    CanalValidacao *canal = calloc(1, sizeof(CanalValidacao));
+    if (!canal)
+        return NULL;
+
+    if (pipe(canal->pipe_acordar) < 0)
+    {
+        free(canal);
+        return NULL;
+    }
+    fcntl(canal->pipe_acordar[0], F_SETFL, O_NONBLOCK);
+    fcntl(canal->pipe_acordar[1], F_SETFL, O_NONBLOCK);
+
+    for (size_t i = 0; i < CAPACIDADE_FILA; i++)
+        atomic_init(&canal->fila[i].sequencia, i);
+    atomic_init(&canal->cauda, 0);
+    atomic_init(&canal->ativo, 0);
+    canal->jogo_terminado = jogo_terminado;
+    canal->unidades_recusadas = unidades_recusadas;
+    canal->arg_callbacks = arg;
+    canal->sockfd = -1;
+    canal->drenado = 1;
+
+    pthread_mutex_init(&canal->mutex, NULL);
+    pthread_cond_init(&canal->mudou, NULL);
+
+    if (pthread_create(&canal->thread, NULL, thread_es, canal) != 0)
+    {
+        pthread_mutex_destroy(&canal->mutex);
+        pthread_cond_destroy(&canal->mudou);
+        close(canal->pipe_acordar[0]);
+        close(canal->pipe_acordar[1]);
+        free(canal);
+        return NULL;
+    }
+    return canal;
+}
+
+void canal_validacao_destruir(CanalValidacao *canal)
+{
+    if (!canal)
+        return;
+
+    canal_validacao_terminar_jogo(canal);
+
+    pthread_mutex_lock(&canal->mutex);
+    canal->a_terminar = 1;
+    pthread_cond_broadcast(&canal->mudou);
+    pthread_mutex_unlock(&canal->mutex);
+    pthread_join(canal->thread, NULL);
+
+    pthread_mutex_destroy(&canal->mutex);
+    pthread_cond_destroy(&canal->mudou);
+    close(canal->pipe_acordar[0]);
+    close(canal->pipe_acordar[1]);
+    free(canal);
+}
+
+void canal_validacao_iniciar_jogo(CanalValidacao *canal, int sockfd, int idCliente)
+{
+    pthread_mutex_lock(&canal->mutex);
+    canal->sockfd = sockfd;
+    canal->idCliente = idCliente;
+    canal->ligacao_perdida = 0;
+    canal->enviados = 0;
+    canal->respostas_ok = 0;
+    canal->respostas_nok = 0;
+    canal->cancelados = 0;
+    canal->max_em_voo = 0;
+    canal->drenado = 0;
+    canal->em_jogo = 1;
+    atomic_store(&canal->ativo, 1);
+    pthread_cond_broadcast(&canal->mudou);
+    pthread_mutex_unlock(&canal->mutex);
+}
+
+int canal_validacao_submeter(CanalValidacao *canal, const Tabuleiro *tabuleiro, uint32_t unidades,
+                             int thread_id, ConclusaoValidacao *conclusao)
+{
+    if (!atomic_load_explicit(&canal->ativo, memory_order_acquire))
+        return 0;
+
+    size_t pos = atomic_load_explicit(&canal->cauda, memory_order_relaxed);
+    CelulaFila *celula;
+    for (;;)
+    {
+        celula = &canal->fila[pos & (CAPACIDADE_FILA - 1)];
+        size_t seq = atomic_load_explicit(&celula->sequencia, memory_order_acquire);
+        intptr_t diferenca = (intptr_t)seq - (intptr_t)pos;
+
+        if (diferenca == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&canal->cauda, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        else if (diferenca < 0)
+        {
+            return 0; // Cheia
+        }
+        else
+        {
+            pos = atomic_load_explicit(&canal->cauda, memory_order_relaxed);
+        }
+    }
+
+    conclusao->unidades = unidades;
+    conclusao->veredicto = 0;
+    atomic_store_explicit(&conclusao->estado, VALIDACAO_PENDENTE, memory_order_relaxed);
+
+    celula->pedido.tabuleiro = *tabuleiro;
+    celula->pedido.unidades = unidades;
+    celula->pedido.thread_id = thread_id;
+    celula->pedido.conclusao = conclusao;
+    atomic_store_explicit(&celula->sequencia, pos + 1, memory_order_release);
+
+    acordar(canal);
+    return 1;
+}
+
+void canal_validacao_terminar_jogo(CanalValidacao *canal)
+{
+    pthread_mutex_lock(&canal->mutex);
+    if (!canal->em_jogo)
+    {
+        pthread_mutex_unlock(&canal->mutex);
+        return;
+    }
+    atomic_store(&canal->ativo, 0);
+    pthread_mutex_unlock(&canal->mutex);
+
+    acordar(canal);
+
+    pthread_mutex_lock(&canal->mutex);
+    while (!canal->drenado)
+        pthread_cond_wait(&canal->mudou, &canal->mutex);
+    pthread_mutex_unlock(&canal->mutex);
+
+    if (canal->enviados > 0 || canal->cancelados > 0)
+    {
+        char log_msg[256];
+        snprintf(log_msg, sizeof(log_msg), "[E/S] Validações do jogo: %d enviadas, %d OK, %d NOK, %d canceladas, máx. %d em voo.",
+                 canal->enviados, canal->respostas_ok, canal->respostas_nok, canal->cancelados, canal->max_em_voo);
+        registarEventoCliente(EVTC_ERRO, log_msg);
+    }
+}
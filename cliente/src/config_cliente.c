@@ -10,6 +10,16 @@
  * - PORTA: Porta TCP do servidor
  * - ID_CLIENTE: Identificador único deste cliente
  * - LOG: Caminho para ficheiro de log do cliente
+ * - NUM_THREADS: Número de threads do solver paralelo (0 = uma por core)
+ * - HEURISTICA: Escolha da célula a ramificar (PRIMEIRA ou MRV)
+ * - PROPAGACAO: 1 para deduzir células forçadas (naked/hidden singles), 0 para desligar
+ * - MOTOR: Motor de resolução (BACKTRACKING, DLX, BITBOARD, PORTFOLIO ou SAT)
+ * - TABELA_TRANSPOSICAO: log2 das entradas da tabela de posições refutadas (0 = desligada)
+ * - SEMENTE: pesquisa determinística com esta semente (0 = aleatória)
+ * - ORACULO: 1 para cortar a pesquisa com os blocos que o servidor recusa
+ * - RITMO: pausas de apresentação (DESLIGADO, FIXO ou LIMITADO)
+ * - RITMO_ATRASO_MS: pausa de cada evento no modo FIXO
+ * - RITMO_POR_SEGUNDO: máximo de eventos por segundo no modo LIMITADO
  *
  * Formato do ficheiro .conf:
  * PARAMETRO: valor
@@ -62,6 +72,15 @@ int lerConfigCliente(const char *nomeFicheiro, ConfigCliente *config)
     config->porta = -1;
     config->timeoutServidor = -1;
     config->numThreads = -1;
+    config->heuristica = HEURISTICA_MRV; // Opcional: MRV por omissão
+    config->propagacao = 1;              // Opcional: ligada por omissão
+    config->motor = MOTOR_BACKTRACKING;  // Opcional: backtracking por omissão
+    config->bitsTransposicao = 18;       // Opcional: 2^18 entradas (2 MB) por omissão
+    config->semente = 0;                 // Opcional: ordem aleatória por omissão
+    config->oraculo = 0;                 // Opcional: validação só informativa por omissão
+    config->ritmo = RITMO_DESLIGADO;     // Opcional: sem pausas por omissão
+    config->ritmoAtrasoMs = 100;
+    config->ritmoPorSegundo = 10;
     config->ipServidor[0] = '\0';
     config->ficheiroLog[0] = '\0';
 
@@ -156,11 +175,108 @@ int lerConfigCliente(const char *nomeFicheiro, ConfigCliente *config)
         else if (strcmp(chave, "NUM_THREADS") == 0)
         {
             config->numThreads = atoi(valor_limpo);
-            // Validar: mínimo 1, máximo 9
-            if (config->numThreads < 1)
+            // Validar: 0 (automático) até MAX_THREADS_SOLVER
+            if (config->numThreads < 0)
                 config->numThreads = 1;
-            if (config->numThreads > 9)
-                config->numThreads = 9;
+            if (config->numThreads > MAX_THREADS_SOLVER)
+                config->numThreads = MAX_THREADS_SOLVER;
+        }
+        else if (strcmp(chave, "HEURISTICA") == 0)
+        {
+            if (strcmp(valor_limpo, "MRV") == 0)
+            {
+                config->heuristica = HEURISTICA_MRV;
+            }
+            else if (strcmp(valor_limpo, "PRIMEIRA") == 0)
+            {
+                config->heuristica = HEURISTICA_PRIMEIRA;
+            }
+            else
+            {
+                printf("Aviso: HEURISTICA desconhecida '%s' (use PRIMEIRA ou MRV), a usar MRV\n", valor_limpo);
+            }
+        }
+        else if (strcmp(chave, "PROPAGACAO") == 0)
+        {
+            config->propagacao = atoi(valor_limpo) != 0;
+        }
+        else if (strcmp(chave, "TABELA_TRANSPOSICAO") == 0)
+        {
+            config->bitsTransposicao = atoi(valor_limpo);
+            if (config->bitsTransposicao < 0 || config->bitsTransposicao > 30)
+            {
+                printf("Aviso: TABELA_TRANSPOSICAO fora do intervalo (0-30), a usar 18\n");
+                config->bitsTransposicao = 18;
+            }
+        }
+        else if (strcmp(chave, "SEMENTE") == 0)
+        {
+            config->semente = (unsigned int)strtoul(valor_limpo, NULL, 10);
+        }
+        else if (strcmp(chave, "ORACULO") == 0)
+        {
+            config->oraculo = atoi(valor_limpo) != 0;
+        }
+        else if (strcmp(chave, "RITMO") == 0)
+        {
+            if (strcmp(valor_limpo, "DESLIGADO") == 0)
+            {
+                config->ritmo = RITMO_DESLIGADO;
+            }
+            else if (strcmp(valor_limpo, "FIXO") == 0)
+            {
+                config->ritmo = RITMO_FIXO;
+            }
+            else if (strcmp(valor_limpo, "LIMITADO") == 0)
+            {
+                config->ritmo = RITMO_LIMITADO;
+            }
+            else
+            {
+                printf("Aviso: RITMO desconhecido '%s' (use DESLIGADO, FIXO ou LIMITADO), a usar DESLIGADO\n", valor_limpo);
+            }
+        }
+        else if (strcmp(chave, "RITMO_ATRASO_MS") == 0)
+        {
+            config->ritmoAtrasoMs = atoi(valor_limpo);
+            if (config->ritmoAtrasoMs < 0)
+                config->ritmoAtrasoMs = 0;
+        }
+        else if (strcmp(chave, "RITMO_POR_SEGUNDO") == 0)
+        {
+            config->ritmoPorSegundo = atoi(valor_limpo);
+            if (config->ritmoPorSegundo < 1)
+            {
+                printf("Aviso: RITMO_POR_SEGUNDO tem de ser >= 1, a usar 10\n");
+                config->ritmoPorSegundo = 10;
+            }
+        }
+        else if (strcmp(chave, "MOTOR") == 0)
+        {
+            if (strcmp(valor_limpo, "BACKTRACKING") == 0)
+            {
+                config->motor = MOTOR_BACKTRACKING;
+            }
+            else if (strcmp(valor_limpo, "DLX") == 0)
+            {
+                config->motor = MOTOR_DLX;
+            }
+            else if (strcmp(valor_limpo, "BITBOARD") == 0)
+            {
+                config->motor = MOTOR_BITBOARD;
+            }
+            else if (strcmp(valor_limpo, "PORTFOLIO") == 0)
+            {
+                config->motor = MOTOR_PORTFOLIO;
+            }
+            else if (strcmp(valor_limpo, "SAT") == 0)
+            {
+                config->motor = MOTOR_SAT;
+            }
+            else
+            {
+                printf("Aviso: MOTOR desconhecido '%s' (use BACKTRACKING, DLX, BITBOARD, PORTFOLIO ou SAT), a usar BACKTRACKING\n", valor_limpo);
+            }
         }
     }
 
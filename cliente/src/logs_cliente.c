@@ -86,12 +86,13 @@ void registarEventoCliente(CodigoEventoCliente evento, const char *descricao)
     }
 
     time_t agora;
-    struct tm *info_tempo;
+    struct tm info_tempo;
     char buffer_tempo[64];
 
+    // localtime_r: também é chamada pela thread de E/S da validação remota
     time(&agora);
-    info_tempo = localtime(&agora);
-    strftime(buffer_tempo, sizeof(buffer_tempo), "%Y-%m-%d %H:%M:%S", info_tempo);
+    localtime_r(&agora, &info_tempo);
+    strftime(buffer_tempo, sizeof(buffer_tempo), "%Y-%m-%d %H:%M:%S", &info_tempo);
 
     const char *nome_evento = "";
     switch (evento)
@@ -0,0 +1,442 @@
+// cliente/src/main_batch.c - Resolução offline de ficheiros de puzzles
+//
+// Uso: sudoku-batch [-t threads] [-m motor] [-i intercalados] [-o saida.csv] ficheiro
+//
+// Lê puzzles no formato de jogos.txt (id,tabuleiro[,solucao]) ou linhas
+// simples de 81 caracteres ('0' ou '.' = vazia) e resolve-os em paralelo
+// com o motor do cliente, sem rede e sem pausas de demonstração.
+// O ficheiro é lido em lotes (memória constante, serve para milhões de
+// linhas) e cada thread resolve um lote inteiro de cada vez. Com -i (motor
+// BACKTRACKING) o lote é entregue a resolver_sudoku_lote, que avança várias
+// pesquisas à vez na mesma thread; o tempo_us passa a ser a média do lote.
+//
+// Para cada puzzle escreve, pela ordem do ficheiro de entrada:
+//   id,solucao,tempo_us,estado
+// Estados:
+//   OK                 resolvido (e a solução do ficheiro, se existir, é válida)
+//   SEM_SOLUCAO        o solver não encontrou solução
+//   SOLUCAO_INVALIDA   a solução do ficheiro não resolve o puzzle
+//   FORMATO_INVALIDO   linha mal formada
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <time.h>
+#include "solver.h"
+#include "solver_dlx.h"
+#include "solver_bitboard.h"
+#include "solver_sat.h"
+#include "tabuleiro.h"
+#include "verificacao.h"
+
+#define LOTE_LINHAS 256
+#define MAX_LINHA 512
+#define MAX_SAIDA_LINHA 160
+
+typedef struct
+{
+    FILE *entrada;
+    FILE *saida;
+    MotorSolver motor;
+    int intercalados; // 0 = um puzzle de cada vez (resolver_com_motor)
+
+    // Leitura: um lote de cada vez, numerado por ordem do ficheiro
+    pthread_mutex_t leitura_mutex;
+    long proximo_lote;
+    long linhas_lidas;
+
+    // Escrita: os lotes são escritos pela mesma ordem em que foram lidos
+    pthread_mutex_t escrita_mutex;
+    pthread_cond_t escrita_cond;
+    long proximo_a_escrever;
+
+    // Estatísticas (protegidas por escrita_mutex)
+    long total, resolvidos, sem_solucao, solucoes_invalidas, mal_formados;
+} Batch;
+
+// Lê um tabuleiro de texto aceitando '.' como célula vazia
+static int ler_tabuleiro(Tabuleiro *t, const char *texto)
+{
+    if (strlen(texto) != TAB_CELULAS)
+        return 0;
+
+    char copia[TAB_CELULAS + 1];
+    for (int i = 0; i < TAB_CELULAS; i++)
+        copia[i] = (texto[i] == '.') ? '0' : texto[i];
+    copia[TAB_CELULAS] = '\0';
+
+    return tabuleiro_de_texto(t, copia);
+}
+
+static int resolver_com_motor(MotorSolver motor, Tabuleiro *t)
+{
+    switch (motor)
+    {
+    case MOTOR_DLX:
+        return resolver_sudoku_dlx(t);
+    case MOTOR_BITBOARD:
+        return resolver_sudoku_bitboard(t);
+    case MOTOR_PORTFOLIO:
+        return resolver_sudoku_portfolio(t, NULL);
+    case MOTOR_SAT:
+        return resolver_sudoku_sat(t);
+    default:
+        return resolver_sudoku_sequencial(t);
+    }
+}
+
+enum
+{
+    ESTADO_OK,
+    ESTADO_SEM_SOLUCAO,
+    ESTADO_SOLUCAO_INVALIDA,
+    ESTADO_FORMATO_INVALIDO
+};
+
+static const char *nomes_estado[] = {"OK", "SEM_SOLUCAO", "SOLUCAO_INVALIDA", "FORMATO_INVALIDO"};
+
+// Uma linha do ficheiro durante o processamento do lote
+typedef struct
+{
+    char id[32];
+    int formato_valido;
+    int tem_solucao_ficheiro;
+    Tabuleiro puzzle;
+    Tabuleiro solucao_ficheiro;
+    Tabuleiro resolvido;
+    int ok;
+    long tempo_us;
+} PuzzleBatch;
+
+// Interpreta uma linha do ficheiro. Devolve 0 se estiver mal formada.
+static int interpretar_linha(char *linha, long num_linha, PuzzleBatch *p)
+{
+    linha[strcspn(linha, "\r\n")] = '\0';
+
+    // Formato CSV (id,tabuleiro[,solucao]) ou só o tabuleiro
+    char *tabuleiro_txt = linha;
+    char *solucao_txt = NULL;
+
+    char *virgula = strchr(linha, ',');
+    if (virgula)
+    {
+        *virgula = '\0';
+        snprintf(p->id, sizeof(p->id), "%s", linha);
+        tabuleiro_txt = virgula + 1;
+
+        virgula = strchr(tabuleiro_txt, ',');
+        if (virgula)
+        {
+            *virgula = '\0';
+            solucao_txt = virgula + 1;
+
+            // Ignorar colunas extra depois da solução
+            virgula = strchr(solucao_txt, ',');
+            if (virgula)
+                *virgula = '\0';
+        }
+    }
+    else
+    {
+        snprintf(p->id, sizeof(p->id), "%ld", num_linha);
+    }
+
+    p->tem_solucao_ficheiro = solucao_txt != NULL;
+    p->formato_valido = ler_tabuleiro(&p->puzzle, tabuleiro_txt) &&
+                        (!solucao_txt || ler_tabuleiro(&p->solucao_ficheiro, solucao_txt));
+    p->resolvido = p->puzzle;
+    p->ok = 0;
+    p->tempo_us = 0;
+    return p->formato_valido;
+}
+
+static void resolver_puzzle(MotorSolver motor, PuzzleBatch *p)
+{
+    struct timespec inicio, fim;
+
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    p->ok = resolver_com_motor(motor, &p->resolvido);
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+
+    p->tempo_us = (fim.tv_sec - inicio.tv_sec) * 1000000L + (fim.tv_nsec - inicio.tv_nsec) / 1000;
+}
+
+// Resolve os puzzles válidos do lote com resolver_sudoku_lote (numa só
+// thread: o paralelismo entre threads já vem dos lotes)
+static void resolver_intercalado(PuzzleBatch *puzzles, int n)
+{
+    Tabuleiro tabuleiros[LOTE_LINHAS];
+    int resultados[LOTE_LINHAS];
+    int indices[LOTE_LINHAS];
+    int k = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        if (!puzzles[i].formato_valido)
+            continue;
+        indices[k] = i;
+        tabuleiros[k++] = puzzles[i].puzzle;
+    }
+    if (k == 0)
+        return;
+
+    EstatisticasLote estatisticas;
+    resolver_sudoku_lote(tabuleiros, resultados, k, 1, &estatisticas);
+
+    long tempo_medio_us = (long)(estatisticas.segundos * 1e6 / k);
+    for (int j = 0; j < k; j++)
+    {
+        PuzzleBatch *p = &puzzles[indices[j]];
+        p->ok = resultados[j];
+        p->resolvido = tabuleiros[j];
+        p->tempo_us = tempo_medio_us;
+    }
+}
+
+// Escreve o resultado de um puzzle em 'saida'.
+// Devolve o estado (índice em nomes_estado).
+static int concluir_puzzle(const PuzzleBatch *p, char *saida, size_t tamanho)
+{
+    if (!p->formato_valido)
+    {
+        snprintf(saida, tamanho, "%s,,0,%s\n", p->id, nomes_estado[ESTADO_FORMATO_INVALIDO]);
+        return ESTADO_FORMATO_INVALIDO;
+    }
+
+    int estado = ESTADO_OK;
+    if (!p->ok || verificar_solucao_local(&p->resolvido, &p->puzzle) != VERIFICACAO_OK)
+        estado = ESTADO_SEM_SOLUCAO;
+    else if (p->tem_solucao_ficheiro && verificar_solucao_local(&p->solucao_ficheiro, &p->puzzle) != VERIFICACAO_OK)
+        estado = ESTADO_SOLUCAO_INVALIDA;
+
+    char texto[TAB_CELULAS + 1] = "";
+    if (estado != ESTADO_SEM_SOLUCAO)
+        tabuleiro_para_texto(&p->resolvido, texto);
+
+    snprintf(saida, tamanho, "%s,%s,%ld,%s\n", p->id, texto, p->tempo_us, nomes_estado[estado]);
+    return estado;
+}
+
+static void *thread_batch(void *arg)
+{
+    Batch *b = (Batch *)arg;
+
+    char (*linhas)[MAX_LINHA] = malloc(LOTE_LINHAS * sizeof(*linhas));
+    char *saida = malloc(LOTE_LINHAS * MAX_SAIDA_LINHA);
+    PuzzleBatch *puzzles = malloc(LOTE_LINHAS * sizeof(PuzzleBatch));
+    long numeros[LOTE_LINHAS]; // Número de cada linha no ficheiro
+    if (!linhas || !saida || !puzzles)
+    {
+        free(linhas);
+        free(saida);
+        free(puzzles);
+        return NULL;
+    }
+
+    for (;;)
+    {
+        // 1. Ler o próximo lote
+        pthread_mutex_lock(&b->leitura_mutex);
+        long lote = b->proximo_lote++;
+        int n = 0;
+        while (n < LOTE_LINHAS && fgets(linhas[n], MAX_LINHA, b->entrada))
+        {
+            b->linhas_lidas++;
+
+            // Ignorar linhas vazias e comentários
+            if (linhas[n][0] == '\n' || linhas[n][0] == '\r' || linhas[n][0] == '#')
+                continue;
+            numeros[n++] = b->linhas_lidas;
+        }
+        pthread_mutex_unlock(&b->leitura_mutex);
+
+        if (n == 0)
+            break;
+
+        // 2. Resolver o lote sem segurar nenhum lock
+        for (int i = 0; i < n; i++)
+            interpretar_linha(linhas[i], numeros[i], &puzzles[i]);
+
+        if (b->intercalados > 0)
+        {
+            resolver_intercalado(puzzles, n);
+        }
+        else
+        {
+            for (int i = 0; i < n; i++)
+            {
+                if (puzzles[i].formato_valido)
+                    resolver_puzzle(b->motor, &puzzles[i]);
+            }
+        }
+
+        int contagem[4] = {0};
+        size_t usado = 0;
+        for (int i = 0; i < n; i++)
+        {
+            int estado = concluir_puzzle(&puzzles[i], saida + usado, MAX_SAIDA_LINHA);
+            contagem[estado]++;
+            usado += strlen(saida + usado);
+        }
+
+        // 3. Escrever pela ordem do ficheiro
+        pthread_mutex_lock(&b->escrita_mutex);
+        while (b->proximo_a_escrever != lote)
+            pthread_cond_wait(&b->escrita_cond, &b->escrita_mutex);
+
+        fwrite(saida, 1, usado, b->saida);
+        b->total += n;
+        b->resolvidos += contagem[ESTADO_OK] + contagem[ESTADO_SOLUCAO_INVALIDA];
+        b->sem_solucao += contagem[ESTADO_SEM_SOLUCAO];
+        b->solucoes_invalidas += contagem[ESTADO_SOLUCAO_INVALIDA];
+        b->mal_formados += contagem[ESTADO_FORMATO_INVALIDO];
+
+        b->proximo_a_escrever++;
+        pthread_cond_broadcast(&b->escrita_cond);
+        pthread_mutex_unlock(&b->escrita_mutex);
+    }
+
+    free(linhas);
+    free(saida);
+    free(puzzles);
+    return NULL;
+}
+
+static void uso(const char *programa)
+{
+    fprintf(stderr, "Uso: %s [-t threads] [-m BACKTRACKING|DLX|BITBOARD|PORTFOLIO|SAT] [-i intercalados] [-o saida.csv] ficheiro\n", programa);
+    fprintf(stderr, "  -t  Número de threads (por omissão: uma por core)\n");
+    fprintf(stderr, "  -m  Motor de resolução (por omissão: BACKTRACKING)\n");
+    fprintf(stderr, "  -i  Pesquisas avançadas à vez por thread (1-16, só BACKTRACKING)\n");
+    fprintf(stderr, "  -o  Ficheiro de saída (por omissão: stdout)\n");
+    fprintf(stderr, "  ficheiro  CSV id,tabuleiro[,solucao] ou linhas de 81 caracteres ('-' = stdin)\n");
+}
+
+int main(int argc, char *argv[])
+{
+    int num_threads = 0;
+    MotorSolver motor = MOTOR_BACKTRACKING;
+    int intercalados = 0;
+    const char *ficheiro_saida = NULL;
+    int opcao;
+
+    while ((opcao = getopt(argc, argv, "t:m:i:o:h")) != -1)
+    {
+        switch (opcao)
+        {
+        case 't':
+            num_threads = atoi(optarg);
+            break;
+        case 'm':
+            if (strcasecmp(optarg, "DLX") == 0)
+                motor = MOTOR_DLX;
+            else if (strcasecmp(optarg, "BITBOARD") == 0)
+                motor = MOTOR_BITBOARD;
+            else if (strcasecmp(optarg, "PORTFOLIO") == 0)
+                motor = MOTOR_PORTFOLIO;
+            else if (strcasecmp(optarg, "SAT") == 0)
+                motor = MOTOR_SAT;
+            else if (strcasecmp(optarg, "BACKTRACKING") == 0)
+                motor = MOTOR_BACKTRACKING;
+            else
+            {
+                fprintf(stderr, "Motor desconhecido: %s\n", optarg);
+                uso(argv[0]);
+                return 1;
+            }
+            break;
+        case 'i':
+            intercalados = atoi(optarg);
+            if (intercalados < 1)
+                intercalados = 1;
+            break;
+        case 'o':
+            ficheiro_saida = optarg;
+            break;
+        default:
+            uso(argv[0]);
+            return 1;
+        }
+    }
+
+    if (optind >= argc)
+    {
+        uso(argv[0]);
+        return 1;
+    }
+
+    if (intercalados > 0 && motor != MOTOR_BACKTRACKING)
+    {
+        fprintf(stderr, "A opção -i só se aplica ao motor BACKTRACKING\n");
+        return 1;
+    }
+    if (intercalados > 0)
+        set_global_lote_intercalados(intercalados);
+
+    if (num_threads <= 0)
+        num_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (num_threads < 1)
+        num_threads = 1;
+    if (num_threads > MAX_THREADS_SOLVER)
+        num_threads = MAX_THREADS_SOLVER;
+
+    Batch b;
+    memset(&b, 0, sizeof(b));
+    b.motor = motor;
+    b.intercalados = intercalados;
+    pthread_mutex_init(&b.leitura_mutex, NULL);
+    pthread_mutex_init(&b.escrita_mutex, NULL);
+    pthread_cond_init(&b.escrita_cond, NULL);
+
+    b.entrada = strcmp(argv[optind], "-") == 0 ? stdin : fopen(argv[optind], "r");
+    if (!b.entrada)
+    {
+        perror("Erro ao abrir ficheiro de puzzles");
+        return 1;
+    }
+
+    b.saida = ficheiro_saida ? fopen(ficheiro_saida, "w") : stdout;
+    if (!b.saida)
+    {
+        perror("Erro ao criar ficheiro de saída");
+        return 1;
+    }
+
+    const char *nome_motor = motor == MOTOR_DLX ? "DLX" : motor == MOTOR_BITBOARD ? "BITBOARD" : motor == MOTOR_PORTFOLIO ? "PORTFOLIO" : motor == MOTOR_SAT ? "SAT" : "BACKTRACKING";
+    fprintf(stderr, "[BATCH] %s: %d threads, motor %s", argv[optind], num_threads, nome_motor);
+    if (intercalados > 0)
+        fprintf(stderr, ", %d pesquisas intercaladas por thread", intercalados);
+    fprintf(stderr, "\n");
+
+    struct timespec inicio, fim;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+
+    pthread_t threads[MAX_THREADS_SOLVER];
+    int criadas = 0;
+    for (int i = 0; i < num_threads; i++)
+    {
+        if (pthread_create(&threads[criadas], NULL, thread_batch, &b) == 0)
+            criadas++;
+    }
+    for (int i = 0; i < criadas; i++)
+        pthread_join(threads[i], NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+    double segundos = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
+
+    if (b.entrada != stdin)
+        fclose(b.entrada);
+    if (b.saida != stdout)
+        fclose(b.saida);
+
+    fprintf(stderr, "[BATCH] %ld puzzles em %.3fs (%.0f puzzles/s)\n",
+            b.total, segundos, segundos > 0 ? b.total / segundos : 0.0);
+    fprintf(stderr, "[BATCH] Resolvidos: %ld | Sem solução: %ld | Solução do ficheiro inválida: %ld | Mal formados: %ld\n",
+            b.resolvidos, b.sem_solucao, b.solucoes_invalidas, b.mal_formados);
+
+    // Código de saída != 0 se o catálogo tiver problemas
+    return (b.sem_solucao || b.solucoes_invalidas || b.mal_formados) ? 2 : 0;
+}
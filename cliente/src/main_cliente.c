@@ -66,6 +66,10 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    // Semente na linha de comando: sobrepõe-se à SEMENTE da configuração
+    if (argc >= 3)
+        config.semente = (unsigned int)strtoul(argv[2], NULL, 10);
+
     // Validar campos obrigatórios da configuração
     // Sem estas configurações, o cliente não pode funcionar
     if (strlen(config.ipServidor) == 0)
@@ -92,7 +96,25 @@ int main(int argc, char *argv[])
 
     printf("   IP do Servidor: %s\n", config.ipServidor);
     printf("   Porta: %d\n", config.porta);
-    printf("   Threads Paralelas: %d\n", config.numThreads);
+    if (config.numThreads == 0)
+        printf("   Threads Paralelas: automático (uma por core)\n");
+    else
+        printf("   Threads Paralelas: %d\n", config.numThreads);
+    printf("   Heurística: %s\n", config.heuristica == HEURISTICA_MRV ? "MRV" : "PRIMEIRA");
+    printf("   Propagação: %s\n", config.propagacao ? "Ligada" : "Desligada");
+    if (config.bitsTransposicao > 0)
+        printf("   Tabela de Transposição: 2^%d entradas\n", config.bitsTransposicao);
+    else
+        printf("   Tabela de Transposição: Desligada\n");
+    if (config.semente)
+        printf("   Pesquisa: Determinística (semente %u)\n", config.semente);
+    if (config.oraculo)
+        printf("   Oráculo: Ligado (unidades recusadas cortam a pesquisa)\n");
+    if (config.ritmo == RITMO_FIXO)
+        printf("   Ritmo: Fixo (%d ms por evento)\n", config.ritmoAtrasoMs);
+    else if (config.ritmo == RITMO_LIMITADO)
+        printf("   Ritmo: Limitado (%d eventos/s)\n", config.ritmoPorSegundo);
+    printf("   Motor: %s\n", config.motor == MOTOR_DLX ? "DLX" : config.motor == MOTOR_BITBOARD ? "BITBOARD" : config.motor == MOTOR_PORTFOLIO ? "PORTFOLIO" : config.motor == MOTOR_SAT ? "SAT" : "BACKTRACKING");
 
     // Usar PID como ID único do cliente
     int idCliente = getpid();
@@ -100,6 +122,17 @@ int main(int argc, char *argv[])
 
     // Configurar número de threads no solver
     set_global_num_threads(config.numThreads);
+    set_global_heuristica(config.heuristica);
+    set_global_propagacao(config.propagacao);
+    set_global_motor(config.motor);
+    set_global_tabela_transposicao(config.bitsTransposicao);
+    set_global_semente(config.semente);
+    set_global_oraculo(config.oraculo);
+    set_global_ritmo(config.ritmo, config.ritmoAtrasoMs, config.ritmoPorSegundo);
+
+    // Arrancar já as threads do solver: ficam paradas até haver um jogo
+    if (config.motor == MOTOR_BACKTRACKING)
+        iniciar_pool_solver(config.numThreads);
 
     // Inicializar logs do cliente com ID baseado em PID
     // Determinar se estamos em build/ ou raiz usando o ficheiro de config como referência
@@ -185,6 +218,7 @@ int main(int argc, char *argv[])
     // É AQUI que vais implementar a lógica do protocolo.h
     str_cli(stdin, sockfd, idCliente);
 
+    terminar_pool_solver();
     fecharLogCliente();
     close(sockfd);
     exit(0);
@@ -0,0 +1,91 @@
+// cliente/src/ritmo.c - Ritmo artificial da resolução (modo de apresentação)
+//
+// FIXO dorme sempre o mesmo tempo. LIMITADO distribui vagas espaçadas de
+// 1/N segundos por ordem de pedido: cada thread reserva a próxima vaga
+// sob o mutex e dorme fora dele até lá, pelo que o débito total nunca
+// passa de N eventos por segundo, seja qual for o número de threads.
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "ritmo.h"
+
+// Fatia máxima de cada sono, para reagir ao fim do jogo
+#define FATIA_NS 50000000L
+
+struct Ritmo
+{
+    ModoRitmo modo;
+    long intervalo_ns; // FIXO: atraso; LIMITADO: 1/N segundos
+
+    pthread_mutex_t mutex;
+    struct timespec proxima_vaga; // LIMITADO: instante da próxima vaga livre
+};
+
+static void somar_ns(struct timespec *t, long ns)
+{
+    t->tv_nsec += ns;
+    t->tv_sec += t->tv_nsec / 1000000000L;
+    t->tv_nsec %= 1000000000L;
+}
+
+static int antes(const struct timespec *a, const struct timespec *b)
+{
+    return a->tv_sec < b->tv_sec || (a->tv_sec == b->tv_sec && a->tv_nsec < b->tv_nsec);
+}
+
+Ritmo *ritmo_criar(ModoRitmo modo, int atraso_ms, int por_segundo)
+{
+    if (modo == RITMO_DESLIGADO)
+        return NULL;
+    if (modo == RITMO_FIXO && atraso_ms <= 0)
+        return NULL;
+    if (modo == RITMO_LIMITADO && por_segundo <= 0)
+        return NULL;
+
+    Ritmo *ritmo = calloc(1, sizeof(Ritmo));
+    if (!ritmo)
+        return NULL;
+
+    ritmo->modo = modo;
+    ritmo->intervalo_ns = modo == RITMO_FIXO ? atraso_ms * 1000000L : 1000000000L / por_segundo;
+    pthread_mutex_init(&ritmo->mutex, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &ritmo->proxima_vaga);
+    return ritmo;
+}
+
+void ritmo_destruir(Ritmo *ritmo)
+{
+    if (!ritmo)
+        return;
+    pthread_mutex_destroy(&ritmo->mutex);
+    free(ritmo);
+}
+
+void ritmo_aguardar(Ritmo *ritmo, const atomic_int *parar)
+{
+    struct timespec agora, ate;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+
+    if (ritmo->modo == RITMO_FIXO)
+    {
+        ate = agora;
+        somar_ns(&ate, ritmo->intervalo_ns);
+    }
+    else
+    {
+        pthread_mutex_lock(&ritmo->mutex);
+        if (antes(&ritmo->proxima_vaga, &agora))
+            ritmo->proxima_vaga = agora;
+        ate = ritmo->proxima_vaga;
+        somar_ns(&ritmo->proxima_vaga, ritmo->intervalo_ns);
+        pthread_mutex_unlock(&ritmo->mutex);
+    }
+
+    while (antes(&agora, &ate) && !(parar && atomic_load(parar)))
+    {
+        struct timespec fatia = agora;
+        somar_ns(&fatia, FATIA_NS);
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, antes(&fatia, &ate) ? &fatia : &ate, NULL);
+        clock_gettime(CLOCK_MONOTONIC, &agora);
+    }
+}
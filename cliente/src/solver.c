@@ -6,17 +6,21 @@
 #include <unistd.h>
 #include <stdint.h>
 #include <time.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <limits.h>
 #include "solver.h"
+#include "solver_dlx.h"
+#include "solver_bitboard.h"
+#include "solver_sat.h"
+#include "transposicao.h"
+#include "canal_validacao.h"
+#include "ritmo.h"
 #include "logs_cliente.h"
 #include "protocolo.h"
 #include "util.h"
 
-static int solucao_encontrada = 0;
-static int tabuleiro_solucao[9][9];
-static int last_num_threads = 0;
-static pthread_mutex_t solucao_mutex = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t log_mutex = PTHREAD_MUTEX_INITIALIZER;
-static pthread_mutex_t socket_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 static void log_thread_safe(const char *msg)
 {
@@ -25,9 +29,262 @@ static void log_thread_safe(const char *msg)
     pthread_mutex_unlock(&log_mutex);
 }
 
-// Valida um bloco 3x3 via comunicação com o servidor
-static void validar_bloco_remoto(int sockfd, int bloco_id, int tabuleiro[9][9], int thread_id, int idCliente)
+// Heurística de escolha de célula (setada pelo main a partir da config)
+static HeuristicaCelula global_heuristica = HEURISTICA_MRV;
+
+void set_global_heuristica(HeuristicaCelula heuristica)
+{
+    global_heuristica = heuristica;
+}
+
+// Propagação de restrições (setada pelo main a partir da config)
+static int global_propagacao = 1;
+
+void set_global_propagacao(int ativa)
+{
+    global_propagacao = ativa;
+}
+
+static inline int banda_completa(const MascarasSudoku *m, int banda)
+{
+    return (m->linhas[banda * 3] & m->linhas[banda * 3 + 1] & m->linhas[banda * 3 + 2]) == TODOS_DIGITOS;
+}
+
+// --- Contexto de resolução ---
+//
+// Todo o estado de uma resolução (pool de threads, deques de tarefas,
+// solução e flag de paragem) vive num SolverContext, pelo que vários
+// contextos podem resolver jogos em simultâneo no mesmo processo.
+// O resolver_sudoku() usa um contexto global, criado pelo main.
+//
+// Escalonador work-stealing: cada thread tem uma deque de tarefas
+// (subárvores por explorar). A dona empilha e retira pelo fundo (LIFO,
+// mantém a cache quente); as threads ociosas roubam pelo topo, onde estão
+// as tarefas mais antigas e, por isso, mais próximas da raiz.
+// Uma thread em pesquisa só parte a sua subárvore quando vê threads
+// ociosas: nesse caso doa os irmãos ainda por explorar do nó atual.
+//
+// Pool persistente: as threads de um contexto são criadas uma vez e ficam
+// paradas numa variável de condição entre jogos. Cada jogo novo incrementa
+// a geração e acorda-as; o chamador espera até todas voltarem. Resolver um
+// jogo não faz nenhuma alocação nem cria threads.
+//
+// Modo determinístico (semente != 0): o work-stealing depende de quem
+// chega primeiro, por isso nesse modo não há roubos, doações nem tabela de
+// transposição. A raiz é expandida numa lista fixa de tarefas (ordem
+// baralhada pela semente) que as threads tiram por ordem de índice; cada
+// tarefa é uma pesquisa sequencial, com o mesmo número de nós em qualquer
+// execução. Fica a solução da tarefa de menor índice: só se abandonam as
+// tarefas posteriores a uma que já tenha solução, e as anteriores acabam
+// sempre. A lista não depende do número de threads, por isso a mesma
+// semente dá a mesma solução e a mesma contagem de nós com 1 ou 64 threads.
+
+#define CAPACIDADE_DEQUE 64
+
+// Tarefas do modo determinístico: a raiz é expandida até haver pelo menos
+// TAREFAS_DETERMINISTICAS (o dobro cabe sempre numa expansão parcial)
+#define TAREFAS_DETERMINISTICAS 128
+#define MAX_TAREFAS_DETERMINISTICAS (2 * TAREFAS_DETERMINISTICAS)
+
+// Conteúdos recusados pelo servidor guardados por unidade (potência de 2)
+#define CAPACIDADE_RECUSADOS 256
+
+typedef struct
+{
+    pthread_mutex_t mutex;
+    Tarefa tarefas[CAPACIDADE_DEQUE]; // Buffer circular
+    int topo;                         // Índice da tarefa mais antiga
+    int n;                            // Número de tarefas na deque
+} DequeTrabalho;
+
+struct SolverContext
+{
+    // Paragem: lida pelas threads em cada nó, escrita por qualquer thread
+    atomic_int parar;    // != 0 = abandonar a pesquisa
+    atomic_int motivo;   // MotivoParagem (fica a primeira causa)
+    atomic_int vencedor; // Cliente indicado pelo servidor no JOGO_TERMINADO
+
+    // Prazo opcional (0 = sem prazo), convertido em instante absoluto por jogo
+    double prazo_segundos;
+    struct timespec prazo;
+
+    // Solução encontrada
+    pthread_mutex_t solucao_mutex;
+    int tem_solucao;
+    Tabuleiro tabuleiro_solucao;
+
+    // Validação remota assíncrona (criado no primeiro jogo com servidor)
+    CanalValidacao *canal;
+
+    // Ritmo de apresentação (NULL = sem pausas)
+    Ritmo *ritmo;
+
+    // Oráculo: conteúdos de unidades completas (blocos, linhas, colunas)
+    // que o servidor recusou neste jogo (chave_unidade, 0 = vazia), pela
+    // ordem dos bits UNIDADE_*. Escritos só pela thread de E/S.
+    int oraculo;
+    _Atomic uint64_t recusados[NUM_UNIDADES][CAPACIDADE_RECUSADOS];
+    atomic_int num_recusados;
+    atomic_long podas_oraculo;
+
+    // Work-stealing
+    DequeTrabalho deques[MAX_THREADS_SOLVER];
+    atomic_int tarefas_pendentes;     // Tarefas criadas e ainda não terminadas
+    atomic_int trabalhadores_ociosos; // Threads à procura de trabalho
+
+    // Pool persistente de threads
+    pthread_mutex_t mutex;
+    pthread_cond_t novo_jogo;      // As threads esperam aqui entre jogos
+    pthread_cond_t jogo_terminado; // O chamador espera aqui pelo fim do jogo
+    pthread_t threads[MAX_THREADS_SOLVER];
+    ThreadArgs args[MAX_THREADS_SOLVER];
+    int num_threads;       // Threads em execução no pool
+    unsigned long geracao; // Incrementada a cada jogo entregue
+    int ativas;            // Threads ainda a trabalhar no jogo atual
+    int a_terminar;        // Pedido de encerramento do pool
+
+    pthread_mutex_t jogo_mutex; // Um jogo de cada vez por contexto
+    int last_num_threads;
+
+    // Posições refutadas, partilhadas pelas threads e mantidas entre jogos
+    // (um tabuleiro sem solução continua sem solução no jogo seguinte)
+    TabelaTransposicao *tt;
+    atomic_long tt_acertos; // Acumulados de todos os jogos
+    atomic_long tt_falhas;
+
+    // Modo determinístico (semente 0 = desligado)
+    unsigned int semente;
+    Tarefa tarefas_det[MAX_TAREFAS_DETERMINISTICAS];
+    Tarefa tarefas_det_aux[MAX_TAREFAS_DETERMINISTICAS]; // Nível seguinte ao expandir
+    long nos_tarefa[MAX_TAREFAS_DETERMINISTICAS];
+    int num_tarefas_det;
+    atomic_int proxima_tarefa;
+    atomic_int melhor_tarefa; // Menor índice com solução (INT_MAX = nenhuma)
+};
+
+// Pede a paragem da pesquisa. O primeiro motivo registado é o que fica.
+static void contexto_parar(SolverContext *ctx, MotivoParagem motivo)
+{
+    int esperado = PARAGEM_NENHUMA;
+    atomic_compare_exchange_strong(&ctx->motivo, &esperado, (int)motivo);
+    atomic_store(&ctx->parar, 1);
+}
+
+// ctx == NULL: pesquisa sequencial sem pool (resolver_sudoku_sequencial, portfolio)
+static inline int parado(const SolverContext *ctx)
+{
+    return ctx && atomic_load_explicit(&ctx->parar, memory_order_relaxed);
+}
+
+// Modo determinístico: já há solução numa tarefa anterior a esta
+static inline int tarefa_descartada(const ThreadArgs *t)
+{
+    const SolverContext *ctx = t->ctx;
+    return ctx && ctx->semente &&
+           t->tarefa_atual > atomic_load_explicit(&ctx->melhor_tarefa, memory_order_relaxed);
+}
+
+// Oráculo ligado para este contexto (nunca no modo determinístico: as
+// respostas do servidor chegam em instantes que variam de execução para execução)
+static inline int oraculo_ativo(const SolverContext *ctx)
+{
+    return ctx && ctx->oraculo && !ctx->semente;
+}
+
+// Unidades numeradas como os bits UNIDADE_* do protocolo: 0-8 blocos,
+// 9-17 linhas, 18-26 colunas. Devolve o índice (linha * 9 + coluna) da
+// k-ésima célula da unidade; nos blocos, por ordem de linhas.
+static inline int celula_da_unidade(int unidade, int k)
+{
+    if (unidade < 9)
+        return ((unidade / 3) * 3 + k / 3) * 9 + (unidade % 3) * 3 + k % 3;
+    if (unidade < 18)
+        return (unidade - 9) * 9 + k;
+    return k * 9 + (unidade - 18);
+}
+
+static inline int unidade_contem(int unidade, int celula)
+{
+    int row = celula / 9, col = celula % 9;
+    if (unidade < 9)
+        return BLOCO_DE(row, col) == unidade;
+    if (unidade < 18)
+        return row == unidade - 9;
+    return col == unidade - 18;
+}
+
+static inline int unidade_completa(const MascarasSudoku *m, int unidade)
 {
+    uint16_t mascara = unidade < 9 ? m->blocos[unidade] : unidade < 18 ? m->linhas[unidade - 9] : m->colunas[unidade - 18];
+    return mascara == TODOS_DIGITOS;
+}
+
+// Conteúdo de uma unidade numa chave de 36 bits (4 por célula). Uma
+// unidade completa nunca dá 0.
+static inline uint64_t chave_unidade(const Tabuleiro *tabuleiro, int unidade)
+{
+    uint64_t chave = 0;
+
+    for (int k = 0; k < 9; k++)
+        chave = (chave << 4) | tabuleiro->celulas[celula_da_unidade(unidade, k)];
+    return chave;
+}
+
+static inline unsigned int posicao_recusado(uint64_t chave)
+{
+    return (unsigned int)((chave * 0x9E3779B97F4A7C15ull) >> 56) & (CAPACIDADE_RECUSADOS - 1);
+}
+
+static int unidade_recusada(SolverContext *ctx, int unidade, uint64_t chave)
+{
+    unsigned int pos = posicao_recusado(chave);
+
+    for (int i = 0; i < CAPACIDADE_RECUSADOS; i++)
+    {
+        uint64_t guardada = atomic_load_explicit(&ctx->recusados[unidade][pos], memory_order_acquire);
+        if (guardada == chave)
+            return 1;
+        if (guardada == 0)
+            return 0;
+        pos = (pos + 1) & (CAPACIDADE_RECUSADOS - 1);
+    }
+    return 0;
+}
+
+// Verificação feita em cada nó da pesquisa
+static inline int deve_parar(ThreadArgs *t)
+{
+    SolverContext *ctx = t->ctx;
+
+    t->nos++;
+    if (!ctx)
+        return t->cancelar && atomic_load_explicit(t->cancelar, memory_order_relaxed);
+    if (parado(ctx) || tarefa_descartada(t))
+        return 1;
+
+    // Prazo: ler o relógio só de 1024 em 1024 nós
+    if (ctx->prazo_segundos > 0 && (t->nos & 0x3FF) == 0)
+    {
+        struct timespec agora;
+        clock_gettime(CLOCK_MONOTONIC, &agora);
+        if (agora.tv_sec > ctx->prazo.tv_sec ||
+            (agora.tv_sec == ctx->prazo.tv_sec && agora.tv_nsec >= ctx->prazo.tv_nsec))
+        {
+            contexto_parar(ctx, PARAGEM_PRAZO);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Pede ao servidor, num só VALIDAR_TABULEIRO, a validação das unidades
+// indicadas para a banda, sem esperar pela resposta: o pedido entra na fila
+// do canal de E/S e a thread continua a pesquisa. A resposta chega mais
+// tarde à conclusão da banda.
+static int validar_unidades_remoto(ThreadArgs *t, int banda, uint32_t unidades, const Tabuleiro *tabuleiro)
+{
+    SolverContext *ctx = t->ctx;
+    int thread_id = t->id;
     const char *colors[] = {
         "\033[1;31m",
         "\033[1;32m",
@@ -38,371 +295,1730 @@ static void validar_bloco_remoto(int sockfd, int bloco_id, int tabuleiro[9][9],
     const char *reset = "\033[0m";
     const char *color = colors[thread_id % 6];
 
-    char log_msg[256];
-    snprintf(log_msg, sizeof(log_msg), "%s[Thread %d] A tentar adquirir o Mutex do Socket...%s", color, thread_id, reset);
-    log_thread_safe(log_msg);
-
-    pthread_mutex_lock(&socket_mutex);
+    ConclusaoValidacao *conclusao = &t->validacoes[banda];
 
-    snprintf(log_msg, sizeof(log_msg), "%s[Thread %d] Mutex adquirido! A enviar validação do Bloco %d...%s", color, thread_id, bloco_id, reset);
-    log_thread_safe(log_msg);
-
-    usleep(100000);
+    // Jogo já terminado ou pesquisa cancelada: não falar mais com o servidor
+    if (parado(ctx) || !ctx->canal)
+        return 0;
 
-    MensagemSudoku msg;
-    bzero(&msg, sizeof(msg));
-    msg.tipo = VALIDAR_BLOCO;
-    msg.bloco_id = bloco_id;
-    msg.idCliente = idCliente;
+    // O pedido anterior desta banda ainda não teve resposta
+    if (atomic_load_explicit(&conclusao->estado, memory_order_acquire) == VALIDACAO_PENDENTE)
+        return 0;
 
-    // Extrair dados do bloco
-    int start_row = (bloco_id / 3) * 3;
-    int start_col = (bloco_id % 3) * 3;
-    int k = 0;
-    for (int r = 0; r < 3; r++)
+    // Não voltar a perguntar por unidades com o mesmo conteúdo (as colunas
+    // completas seguem com todas as bandas)
+    uint64_t chaves[NUM_UNIDADES];
+    for (uint32_t resto = unidades; resto; resto &= resto - 1)
     {
-        for (int c = 0; c < 3; c++)
-        {
-            msg.conteudo_bloco[k++] = tabuleiro[start_row + r][start_col + c];
-        }
+        int u = __builtin_ctz(resto);
+        chaves[u] = chave_unidade(tabuleiro, u);
+        if (chaves[u] == t->chaves_validadas[u])
+            unidades &= ~(1u << u);
     }
+    if (!unidades)
+        return 0;
+
+    // Fila cheia: fica por validar (com o oráculo volta a tentar no próximo nó)
+    if (!canal_validacao_submeter(ctx->canal, tabuleiro, unidades, thread_id, conclusao))
+        return 0;
+    for (uint32_t resto = unidades; resto; resto &= resto - 1)
+        t->chaves_validadas[__builtin_ctz(resto)] = chaves[__builtin_ctz(resto)];
+
+    char log_msg[256];
+    snprintf(log_msg, sizeof(log_msg), "%s[Thread %d] Validação da Banda %d em fila: %d blocos, %d linhas, %d colunas (sem esperar pela resposta).%s",
+             color, thread_id, banda,
+             __builtin_popcount(unidades & 0x1FFu),
+             __builtin_popcount((unidades >> 9) & 0x1FFu),
+             __builtin_popcount((unidades >> 18) & 0x1FFu), reset);
+    log_thread_safe(log_msg);
+    return 1;
+}
+
+// Unidades recusadas pelo servidor (chamada pela thread de E/S): com o
+// oráculo, o conteúdo das completas passa a cortar a pesquisa de todas as threads
+static void canal_unidades_recusadas(void *arg, const Tabuleiro *tabuleiro, uint32_t recusadas)
+{
+    SolverContext *ctx = arg;
 
-    if (writen(sockfd, (char *)&msg, sizeof(msg)) == sizeof(msg))
+    if (!oraculo_ativo(ctx))
+        return;
+
+    for (uint32_t resto = recusadas & TODAS_UNIDADES; resto; resto &= resto - 1)
     {
-        MensagemSudoku resp;
-        if (readn(sockfd, (char *)&resp, sizeof(resp)) == sizeof(resp))
+        int u = __builtin_ctz(resto);
+        uint64_t chave = chave_unidade(tabuleiro, u);
+
+        // Unidade incompleta: não diz nada sobre as completas
+        int completa = 1;
+        for (int k = 0; k < 9 && completa; k++)
+            completa = tabuleiro->celulas[celula_da_unidade(u, k)] != 0;
+        if (!completa)
+            continue;
+
+        // Só esta thread escreve: basta a primeira entrada livre da sequência
+        unsigned int pos = posicao_recusado(chave);
+        for (int i = 0; i < CAPACIDADE_RECUSADOS; i++)
         {
-            snprintf(log_msg, sizeof(log_msg), "%s[Thread %d] Resposta recebida do servidor: %s%s", color, thread_id, resp.resposta, reset);
-            log_thread_safe(log_msg);
+            uint64_t guardada = atomic_load_explicit(&ctx->recusados[u][pos], memory_order_relaxed);
+            if (guardada == chave)
+                break;
+            if (guardada == 0)
+            {
+                atomic_store_explicit(&ctx->recusados[u][pos], chave, memory_order_release);
+                atomic_fetch_add_explicit(&ctx->num_recusados, 1, memory_order_release);
+                break;
+            }
+            pos = (pos + 1) & (CAPACIDADE_RECUSADOS - 1);
         }
     }
+}
 
-    pthread_mutex_unlock(&socket_mutex);
+// Resposta JOGO_TERMINADO a uma validação (chamada pela thread de E/S):
+// outro cliente ganhou, parar já todas as threads
+static void canal_jogo_terminado(void *arg, int vencedor)
+{
+    SolverContext *ctx = arg;
 
-    snprintf(log_msg, sizeof(log_msg), "%s[Thread %d] Mutex libertado.%s", color, thread_id, reset);
-    log_thread_safe(log_msg);
+    atomic_store(&ctx->vencedor, vencedor);
+    contexto_parar(ctx, PARAGEM_JOGO_TERMINADO);
 }
 
-static int eh_valido_int(int tabuleiro[9][9], int row, int col, int num);
-static int resolver_sudoku_sequencial_int(int tabuleiro[9][9], int thread_id, int *max_row_reached, int sockfd, int idCliente);
-
-static int eh_valido_int(int tabuleiro[9][9], int row, int col, int num)
+static int deque_empilhar(DequeTrabalho *d, const Tarefa *tarefa)
 {
-    int startRow = (row / 3) * 3;
-    int startCol = (col / 3) * 3;
-
-    for (int i = 0; i < 9; i++)
+    pthread_mutex_lock(&d->mutex);
+    if (d->n == CAPACIDADE_DEQUE)
     {
-        // Linha
-        if (tabuleiro[row][i] == num)
-            return 0;
-        // Coluna
-        if (tabuleiro[i][col] == num)
-            return 0;
-        // Bloco
-        if (tabuleiro[startRow + i / 3][startCol + i % 3] == num)
-            return 0;
+        pthread_mutex_unlock(&d->mutex);
+        return 0;
     }
+    d->tarefas[(d->topo + d->n) % CAPACIDADE_DEQUE] = *tarefa;
+    d->n++;
+    pthread_mutex_unlock(&d->mutex);
     return 1;
 }
 
-// Solver sequencial usado pelas threads
-static int resolver_sudoku_sequencial_int(int tabuleiro[9][9], int thread_id, int *max_row_reached, int sockfd, int idCliente)
+// Dona: retira a tarefa mais recente (fundo)
+static int deque_retirar_fundo(DequeTrabalho *d, Tarefa *tarefa)
 {
-    // Otimização: Verificar se outra thread já resolveu
-    if (solucao_encontrada)
+    pthread_mutex_lock(&d->mutex);
+    if (d->n == 0)
+    {
+        pthread_mutex_unlock(&d->mutex);
         return 0;
+    }
+    d->n--;
+    *tarefa = d->tarefas[(d->topo + d->n) % CAPACIDADE_DEQUE];
+    pthread_mutex_unlock(&d->mutex);
+    return 1;
+}
 
-    int row = -1, col = -1;
-    int isEmpty = 0;
-
-    // Encontrar célula vazia
-    for (int i = 0; i < 9; i++)
+// Ladrão: retira a tarefa mais antiga (topo)
+static int deque_roubar_topo(DequeTrabalho *d, Tarefa *tarefa)
+{
+    pthread_mutex_lock(&d->mutex);
+    if (d->n == 0)
     {
-        for (int j = 0; j < 9; j++)
-        {
-            if (tabuleiro[i][j] == 0)
-            {
-                row = i;
-                col = j;
-                isEmpty = 1;
-                break;
-            }
-        }
-        if (isEmpty)
-            break;
+        pthread_mutex_unlock(&d->mutex);
+        return 0;
     }
+    *tarefa = d->tarefas[d->topo];
+    d->topo = (d->topo + 1) % CAPACIDADE_DEQUE;
+    d->n--;
+    pthread_mutex_unlock(&d->mutex);
+    return 1;
+}
 
-    // Caso base: resolvido
-    if (!isEmpty)
+// Doa à própria deque os candidatos ainda por explorar deste nó.
+// Devolve os candidatos que não couberam (ficam para a thread atual).
+static uint16_t doar_irmaos(ThreadArgs *t, const Tabuleiro *tabuleiro, int row, int col, uint16_t candidatos, int bandas_validadas)
+{
+    SolverContext *ctx = t->ctx;
+    Tarefa tarefa;
+    tarefa.tabuleiro = *tabuleiro;
+    tarefa.linha = row;
+    tarefa.coluna = col;
+    tarefa.bandas_validadas = bandas_validadas;
+
+    while (candidatos)
     {
-        // Validar a última banda (blocos 7, 8, 9)
-        for (int k = 0; k < 3; k++)
+        tarefa.numero = __builtin_ctz(candidatos) + 1;
+
+        // Contar antes de publicar: o total nunca chega a 0 por engano
+        atomic_fetch_add(&ctx->tarefas_pendentes, 1);
+        if (!deque_empilhar(&ctx->deques[t->id], &tarefa))
         {
-            validar_bloco_remoto(sockfd, 7 + k, tabuleiro, thread_id, idCliente);
-            usleep(20000);
+            atomic_fetch_sub(&ctx->tarefas_pendentes, 1);
+            break;
         }
-        return 1;
+        candidatos &= candidatos - 1;
     }
+    return candidatos;
+}
+
+// LOG DE PROGRESSO + Validação Parcial (Demo Mode)
+// Quando uma banda de blocos (3 linhas) fica completa pela primeira vez
+// nesta thread, registamos e validamos no servidor, num só pedido, os seus
+// 3 blocos, as suas 3 linhas e as colunas já completas. Com o oráculo a
+// banda é validada sempre que fica completa com outro conteúdo. Com a
+// heurística MRV as bandas não ficam completas por ordem.
+static void validar_bandas(ThreadArgs *t, const Tabuleiro *tabuleiro, const MascarasSudoku *m, int *bandas_validadas)
+{
+    // Sem servidor (ferramentas offline) não há nada a validar
+    if (t->sockfd < 0)
+        return;
+
+    int oraculo = oraculo_ativo(t->ctx);
 
-    // LOG DE PROGRESSO (Demo Mode)
-    // Se alcançámos uma nova linha mais profunda, registamos
-    if (row > *max_row_reached)
+    for (int banda = 0; banda < 3; banda++)
     {
-        *max_row_reached = row;
-        char msg[100];
-        snprintf(msg, sizeof(msg), "[Thread %d] A avançar para a linha %d...", thread_id, row);
-        log_thread_safe(msg);
+        int primeira = !(*bandas_validadas & (1 << banda));
+        if ((!primeira && !oraculo) || !banda_completa(m, banda))
+            continue;
 
-        // Validação Parcial (Demo)
-        // Valida os blocos da linha anterior quando mudamos de "banda" de blocos (linhas 3 e 6)
-        if (row % 3 == 0 && row > 0)
-        {
-            int banda_anterior = (row / 3) - 1;
-            int bloco_inicio = banda_anterior * 3 + 1;
+        *bandas_validadas |= 1 << banda;
 
-            // Validar TODOS os 3 blocos da banda anterior
-            for (int k = 0; k < 3; k++)
-            {
-                int bloco = bloco_inicio + k;
-                validar_bloco_remoto(sockfd, bloco, tabuleiro, thread_id, idCliente);
-                usleep(20000);
-            }
+        if (primeira)
+        {
+            char msg[100];
+            snprintf(msg, sizeof(msg), "[Thread %d] Banda %d completa (linhas %d-%d)...",
+                     t->id, banda, banda * 3, banda * 3 + 2);
+            log_thread_safe(msg);
         }
-    }
 
-    // Tentar números 1-9
-    for (int num = 1; num <= 9; num++)
-    {
-        if (eh_valido_int(tabuleiro, row, col, num))
+        // Blocos 0-8 por linhas: a banda b tem os blocos 3b, 3b+1 e 3b+2
+        // e as linhas 3b, 3b+1 e 3b+2
+        uint32_t unidades = 0;
+        for (int k = 0; k < 3; k++)
+            unidades |= UNIDADE_BLOCO(banda * 3 + k) | UNIDADE_LINHA(banda * 3 + k);
+        for (int col = 0; col < 9; col++)
         {
-            tabuleiro[row][col] = num;
+            if (m->colunas[col] == TODOS_DIGITOS)
+                unidades |= UNIDADE_COLUNA(col);
+        }
 
-            if (resolver_sudoku_sequencial_int(tabuleiro, thread_id, max_row_reached, sockfd, idCliente))
-            {
-                return 1;
-            }
+        if (validar_unidades_remoto(t, banda, unidades, tabuleiro) && t->ctx->ritmo)
+            ritmo_aguardar(t->ctx->ritmo, &t->ctx->parar);
+    }
+}
 
-            tabuleiro[row][col] = 0; // Backtrack
+// Ponto de decisão na pilha explícita
+typedef struct
+{
+    int row, col;
+    uint16_t candidatos; // Candidatos ainda por tentar nesta célula
+    int inicio_trilho;   // Tamanho do trilho antes de qualquer tentativa
+    int ramos;           // Candidatos iniciais
+    int completa;        // 0 se parte da subárvore foi doada (esgotar não prova nada)
+} Decisao;
+
+// Pesquisa iterativa retomável. Todo o estado que numa versão recursiva
+// viveria na pilha de C está aqui, o que permite avançar várias pesquisas
+// independentes à vez na mesma thread (resolver_sudoku_lote).
+typedef struct
+{
+    Tabuleiro *tabuleiro;
+    MascarasSudoku *m;
+    ListaVazias vazias;
+    Decisao pilha[81];
+    int topo;
+    int trilho[81]; // Trilho único com todas as colocações (escolhas e deduções)
+    int n_trilho;
+    int descer;     // 1: o próximo passo abre um nó novo; 0: tenta o candidato seguinte do topo
+
+    // Estratégia (por omissão a configurada; o portfolio varia-a)
+    HeuristicaCelula heuristica;
+    int propagacao;
+    unsigned int *semente; // != NULL: tentar os candidatos por ordem aleatória
+
+    // Posições refutadas partilhadas (NULL = sem tabela)
+    TabelaTransposicao *tt;
+    uint64_t chave; // Zobrist do tabuleiro atual, mantida pelo trilho
+} Pesquisa;
+
+typedef enum
+{
+    PESQUISA_A_CORRER = 0,
+    PESQUISA_RESOLVIDA,
+    PESQUISA_ESGOTADA // Sem solução ou interrompida
+} EstadoPesquisa;
 
-            // Otimização: Se outra thread resolveu entretanto, abortar
-            if (solucao_encontrada)
-                return 0;
-        }
+static void pesquisa_iniciar(Pesquisa *p, Tabuleiro *tabuleiro, MascarasSudoku *m)
+{
+    p->tabuleiro = tabuleiro;
+    p->m = m;
+    vazias_inicializar(&p->vazias, tabuleiro);
+    p->topo = 0;
+    p->n_trilho = 0;
+    p->descer = 1;
+    p->heuristica = global_heuristica;
+    p->propagacao = global_propagacao;
+    p->semente = NULL;
+    p->tt = NULL;
+
+    p->chave = 0;
+    for (int pos = 0; pos < 81; pos++)
+    {
+        if (tabuleiro->celulas[pos])
+            p->chave ^= zobrist_chave(pos, tabuleiro->celulas[pos]);
     }
-    return 0;
 }
 
-void *thread_solver(void *arg)
+// Atualiza a chave com as colocações trilho[inicio..n_trilho) (XOR: serve
+// tanto para as aplicar como para as retirar, antes de desfazer o trilho)
+static inline void pesquisa_atualizar_chave(Pesquisa *p, int inicio)
 {
-    ThreadArgs *args = (ThreadArgs *)arg;
-    char log_msg[256];
-    int max_row_reached = 0; // Para controlo de logs
+    for (int k = inicio; k < p->n_trilho; k++)
+        p->chave ^= zobrist_chave(p->trilho[k], p->tabuleiro->celulas[p->trilho[k]]);
+}
 
-    snprintf(log_msg, sizeof(log_msg), "[Thread %d] A iniciar com numero %d na posicao (%d,%d)",
-             args->id, args->numero_arranque, args->linha_inicial, args->coluna_inicial);
-    log_thread_safe(log_msg);
+// Escolhe um dos candidatos ao acaso (reinícios aleatórios do portfolio)
+static int candidato_aleatorio(uint16_t candidatos, unsigned int *semente)
+{
+    int k = rand_r(semente) % __builtin_popcount(candidatos);
+    while (k--)
+        candidatos &= candidatos - 1;
+    return __builtin_ctz(candidatos) + 1;
+}
 
-    // Simular trabalho para demo (0.1s)
-    usleep(100000);
+// Oráculo: procura nas unidades completas do tabuleiro um conteúdo que o
+// servidor já recusou. Se houver, nenhuma solução passa por este nó nem
+// pela tentativa que completou a unidade: corta a pilha até à decisão dessa
+// tentativa (ou a pesquisa toda, se a unidade já vinha completa) e devolve 1.
+static int oraculo_podar(Pesquisa *p, ThreadArgs *t)
+{
+    SolverContext *ctx = t->ctx;
 
-    // Colocar o número de arranque desta thread
-    args->tabuleiro[args->linha_inicial][args->coluna_inicial] = args->numero_arranque;
+    if (!atomic_load_explicit(&ctx->num_recusados, memory_order_acquire))
+        return 0;
 
-    // Tentar resolver o resto
-    if (resolver_sudoku_sequencial_int(args->tabuleiro, args->id, &max_row_reached, args->sockfd, args->idCliente))
+    for (int u = 0; u < NUM_UNIDADES; u++)
     {
-        pthread_mutex_lock(&solucao_mutex);
-        if (!solucao_encontrada)
-        {
-            solucao_encontrada = 1;
-            // Copiar solução para variável global
-            memcpy(tabuleiro_solucao, args->tabuleiro, sizeof(tabuleiro_solucao));
+        if (!unidade_completa(p->m, u) || !unidade_recusada(ctx, u, chave_unidade(p->tabuleiro, u)))
+            continue;
 
-            snprintf(log_msg, sizeof(log_msg), "[Thread %d] ENCONTREI A SOLUÇÃO!", args->id);
-            log_thread_safe(log_msg);
-        }
-        pthread_mutex_unlock(&solucao_mutex);
-    }
-    else
-    {
-        // Se falhou e ninguém encontrou ainda
-        if (!solucao_encontrada)
+        t->podas_oraculo++;
+
+        // Colocação mais recente do trilho dentro da unidade
+        int ultima = -1;
+        for (int k = p->n_trilho - 1; k >= 0 && ultima < 0; k--)
         {
-            snprintf(log_msg, sizeof(log_msg), "[Thread %d] Falhei. Caminho sem saída.", args->id);
-            log_thread_safe(log_msg);
+            if (unidade_contem(u, p->trilho[k]))
+                ultima = k;
         }
-        else
+        if (ultima < 0 || p->topo == 0)
         {
-            snprintf(log_msg, sizeof(log_msg), "[Thread %d] Abortar. Outra thread já resolveu.", args->id);
-            log_thread_safe(log_msg);
+            p->topo = 0;
+            return 1;
         }
-    }
 
-    free(args); // Libertar memória dos argumentos
-    return NULL;
+        int d = p->topo - 1;
+        while (d > 0 && p->pilha[d].inicio_trilho > ultima)
+            d--;
+        p->topo = d + 1;
+        // Recusa do servidor, não prova de impossibilidade: fora da tabela de transposição
+        p->pilha[d].completa = 0;
+        p->descer = 0;
+        return 1;
+    }
+    return 0;
 }
 
-int resolver_sudoku_paralelo(int tabuleiro_inicial[9][9], int sockfd, int idCliente, int numThreads)
+// Avança a pesquisa um passo: abre um nó novo e/ou faz uma tentativa de
+// candidato. Recuar é desfazer o trilho até ao início da decisão do topo
+// e tentar o candidato seguinte; as células vazias saem de uma lista esparsa.
+static EstadoPesquisa pesquisa_passo(Pesquisa *p, ThreadArgs *t, int *bandas_validadas)
 {
-    // Reset das variáveis globais
-    solucao_encontrada = 0;
-
-    int row = -1, col = -1;
-    int isEmpty = 0;
+    Tabuleiro *tabuleiro = p->tabuleiro;
+    MascarasSudoku *m = p->m;
 
-    // 1. Encontrar a primeira célula vazia para ramificar
-    for (int i = 0; i < 9; i++)
+    if (p->descer)
     {
-        for (int j = 0; j < 9; j++)
-        {
-            if (tabuleiro_inicial[i][j] == 0)
-            {
-                row = i;
-                col = j;
-                isEmpty = 1;
-                break;
-            }
-        }
-        if (isEmpty)
-            break;
-    }
+        // Novo nó: verificar se outra thread já resolveu (ou se foi cancelado)
+        if (deve_parar(t))
+            return PESQUISA_ESGOTADA;
 
-    // Se já estiver resolvido (sem zeros)
-    if (!isEmpty)
-        return 1;
+        // Unidade completa que o servidor recusou: esta subárvore não tem a solução
+        if (oraculo_ativo(t->ctx) && oraculo_podar(p, t))
+            return p->topo ? PESQUISA_A_CORRER : PESQUISA_ESGOTADA;
 
-    // 2. Identificar candidatos válidos
-    int candidatos[9];
-    int num_candidatos = 0;
+        validar_bandas(t, tabuleiro, m, bandas_validadas);
 
-    for (int num = 1; num <= 9; num++)
-    {
-        if (eh_valido_int(tabuleiro_inicial, row, col, num))
+        p->descer = 0;
+
+        // Posição já refutada por esta ou outra thread: tratar como beco sem saída
+        int refutada = 0;
+        if (p->tt)
         {
-            candidatos[num_candidatos++] = num;
+            refutada = transposicao_contem(p->tt, p->chave);
+            if (refutada)
+                t->tt_acertos++;
+            else
+                t->tt_falhas++;
+        }
+
+        if (!refutada)
+        {
+            int row = -1, col = -1;
+            if (escolher_celula(&p->vazias, m, p->heuristica, &row, &col) < 0)
+                return PESQUISA_RESOLVIDA;
+
+            Decisao *d = &p->pilha[p->topo++];
+            d->row = row;
+            d->col = col;
+            d->candidatos = mascaras_candidatos(m, row, col);
+            d->inicio_trilho = p->n_trilho;
+            d->ramos = __builtin_popcount(d->candidatos);
+            d->completa = 1;
         }
     }
 
-    // Se não há candidatos válidos, impossível resolver
-    if (num_candidatos == 0)
-        return 0;
+    if (p->topo == 0)
+        return PESQUISA_ESGOTADA;
 
-    // 3. PID-BASED SHUFFLE: Embaralhar ordem dos candidatos baseado no PID
-    // Isto garante que diferentes clientes exploram em ordens diferentes
-    pid_t pid = getpid();
-    
-    // MELHORAR ENTROPIA: combinar PID + tempo + endereço de memória
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    unsigned int seed = (unsigned int)(pid ^ ts.tv_nsec ^ ((uintptr_t)&seed >> 4));
-    srand(seed);
+    Decisao *d = &p->pilha[p->topo - 1];
 
-    // Fisher-Yates shuffle
-    for (int i = num_candidatos - 1; i > 0; i--)
+    // Backtrack: desfazer a tentativa anterior desta decisão
+    if (p->tt)
+        pesquisa_atualizar_chave(p, d->inicio_trilho);
+    p->vazias.n += p->n_trilho - d->inicio_trilho;
+    desfazer_trilho(tabuleiro, m, p->trilho, &p->n_trilho, d->inicio_trilho);
+
+    if (!d->candidatos)
     {
-        int j = rand() % (i + 1);
-        int temp = candidatos[i];
-        candidatos[i] = candidatos[j];
-        candidatos[j] = temp;
+        // Todos os ramos falharam: a posição deste nó não tem solução.
+        // Nós com um só ramo são baratos de refazer e não ocupam a tabela.
+        if (p->tt && d->completa && d->ramos > 1)
+            transposicao_registar(p->tt, p->chave);
+
+        p->topo--;
+        if (!d->completa && p->topo)
+            p->pilha[p->topo - 1].completa = 0;
+        return p->topo ? PESQUISA_A_CORRER : PESQUISA_ESGOTADA;
     }
 
-    printf("[SHUFFLE] PID=%d: Ordem embaralhada: ", pid);
-    for (int i = 0; i < num_candidatos; i++)
+    // Otimização: Se outra thread resolveu entretanto, abortar
+    if (parado(t->ctx) || tarefa_descartada(t))
+        return PESQUISA_ESGOTADA;
+
+    int num = p->semente ? candidato_aleatorio(d->candidatos, p->semente) : __builtin_ctz(d->candidatos) + 1;
+    d->candidatos &= (uint16_t)~(1u << (num - 1));
+
+    // Há threads sem trabalho: partir aqui e doar os irmãos restantes
+    // (nunca no modo determinístico, onde as tarefas são fixas)
+    if (d->candidatos && t->ctx && !t->ctx->semente && atomic_load_explicit(&t->ctx->trabalhadores_ociosos, memory_order_relaxed) > 0)
     {
-        printf("%d ", candidatos[i]);
+        uint16_t antes = d->candidatos;
+        d->candidatos = doar_irmaos(t, tabuleiro, d->row, d->col, d->candidatos, *bandas_validadas);
+        if (d->candidatos != antes)
+            d->completa = 0;
     }
-    printf("\n");
 
-    // 4. Limitar número de threads ao configurado
-    int threads_a_criar = (num_candidatos < numThreads) ? num_candidatos : numThreads;
+    TAB_CELULA(tabuleiro, d->row, d->col) = (uint8_t)num;
+    mascaras_colocar(m, d->row, d->col, num);
+    p->trilho[p->n_trilho++] = d->row * 9 + d->col;
 
-    pthread_t threads[9];
-    int num_threads = 0;
+    // Deduções forçadas por esta colocação (ficam no mesmo trilho)
+    int consistente = !p->propagacao || propagar(tabuleiro, m, p->trilho, &p->n_trilho);
 
-    for (int i = 0; i < threads_a_criar; i++)
-    {
-        // Preparar argumentos
-        ThreadArgs *args = malloc(sizeof(ThreadArgs));
-        args->id = num_threads;
-        memcpy(args->tabuleiro, tabuleiro_inicial, sizeof(args->tabuleiro));
-        args->linha_inicial = row;
-        args->coluna_inicial = col;
-        args->numero_arranque = candidatos[i]; // Usar ordem embaralhada
-        args->sockfd = sockfd;                 // Passar socket
-        args->idCliente = idCliente;           // Passar ID
+    for (int k = d->inicio_trilho; k < p->n_trilho; k++)
+        vazias_retirar(&p->vazias, p->trilho[k]);
+    if (p->tt)
+        pesquisa_atualizar_chave(p, d->inicio_trilho);
 
-        // Criar thread
-        if (pthread_create(&threads[num_threads], NULL, thread_solver, args) == 0)
-        {
-            num_threads++;
-        }
-        else
-        {
-            free(args);
-        }
-    }
+    if (consistente)
+        p->descer = 1; // Descer para o nó seguinte
 
-    last_num_threads = num_threads; // Guardar contagem
+    return PESQUISA_A_CORRER;
+}
 
-    // 5. Esperar pelas threads
-    printf("[PARALELO] %d/%d threads lançadas (limite: %d) para célula (%d, %d).\n",
-           num_threads, num_candidatos, numThreads, row, col);
-    for (int i = 0; i < num_threads; i++)
+// Solver sequencial usado pelas threads (iterativo): uma única pesquisa
+// avançada até ao fim.
+static int resolver_sudoku_sequencial_int(Tabuleiro *tabuleiro, MascarasSudoku *m, ThreadArgs *t, int *bandas_validadas)
+{
+    Pesquisa p;
+    pesquisa_iniciar(&p, tabuleiro, m);
+    p.tt = (t->ctx && !t->ctx->semente) ? t->ctx->tt : NULL;
+
+    EstadoPesquisa estado;
+    while ((estado = pesquisa_passo(&p, t, bandas_validadas)) == PESQUISA_A_CORRER)
+        ;
+
+    return estado == PESQUISA_RESOLVIDA;
+}
+
+// Explora a subárvore de uma tarefa. Devolve 1 se encontrou a solução.
+static int executar_tarefa(ThreadArgs *t, Tarefa *tarefa)
+{
+    SolverContext *ctx = t->ctx;
+    int bandas_validadas = tarefa->bandas_validadas;
+
+    // Colocar o número de arranque desta tarefa
+    TAB_CELULA(&tarefa->tabuleiro, tarefa->linha, tarefa->coluna) = (uint8_t)tarefa->numero;
+
+    // Máscaras locais (construídas uma vez por tarefa, depois incrementais)
+    MascarasSudoku mascaras;
+    mascaras_inicializar(&mascaras, &tarefa->tabuleiro);
+
+    // Deduções forçadas pelo número de arranque
+    int trilho[81];
+    int n_trilho = 0;
+    int consistente = !global_propagacao || propagar(&tarefa->tabuleiro, &mascaras, trilho, &n_trilho);
+
+    if (!consistente || !resolver_sudoku_sequencial_int(&tarefa->tabuleiro, &mascaras, t, &bandas_validadas))
+        return 0;
+
+    if (ctx->semente)
     {
-        pthread_join(threads[i], NULL);
+        // Fica a solução de menor índice; as outras threads continuam
+        // (as tarefas anteriores a esta têm de acabar)
+        pthread_mutex_lock(&ctx->solucao_mutex);
+        if (t->tarefa_atual < atomic_load(&ctx->melhor_tarefa))
+        {
+            ctx->tem_solucao = 1;
+            ctx->tabuleiro_solucao = tarefa->tabuleiro;
+            atomic_store(&ctx->melhor_tarefa, t->tarefa_atual);
+
+            char log_msg[100];
+            snprintf(log_msg, sizeof(log_msg), "[Thread %d] Solução na tarefa %d.", t->id, t->tarefa_atual);
+            log_thread_safe(log_msg);
+        }
+        pthread_mutex_unlock(&ctx->solucao_mutex);
+        return 1;
     }
 
-    // 6. Verificar se alguma encontrou a solução
-    if (solucao_encontrada)
+    pthread_mutex_lock(&ctx->solucao_mutex);
+    if (!ctx->tem_solucao)
     {
-        memcpy(tabuleiro_inicial, tabuleiro_solucao, sizeof(tabuleiro_solucao));
-        return 1;
+        ctx->tem_solucao = 1;
+        // Copiar solução para o contexto
+        ctx->tabuleiro_solucao = tarefa->tabuleiro;
+
+        char log_msg[100];
+        snprintf(log_msg, sizeof(log_msg), "[Thread %d] ENCONTREI A SOLUÇÃO!", t->id);
+        log_thread_safe(log_msg);
     }
+    pthread_mutex_unlock(&ctx->solucao_mutex);
 
-    return 0;
+    contexto_parar(ctx, PARAGEM_SOLUCAO);
+    return 1;
 }
 
-int get_num_threads_last_run()
+// Procura trabalho: primeiro na própria deque, depois nas das outras threads
+static int obter_tarefa(ThreadArgs *t, Tarefa *tarefa)
 {
-    return last_num_threads;
-}
+    SolverContext *ctx = t->ctx;
 
-// Variável global para armazenar a config (será setada pelo main)
-static int global_num_threads = 9;
+    if (deque_retirar_fundo(&ctx->deques[t->id], tarefa))
+        return 1;
 
-void set_global_num_threads(int num)
-{
-    global_num_threads = num;
+    for (int k = 1; k < t->num_trabalhadores; k++)
+    {
+        int vitima = (t->id + k) % t->num_trabalhadores;
+        if (deque_roubar_topo(&ctx->deques[vitima], tarefa))
+        {
+            t->tarefas_roubadas++;
+            return 1;
+        }
+    }
+    return 0;
 }
 
-int resolver_sudoku(char *tabuleiro, int sockfd, int idCliente)
+// Modo determinístico: tirar as tarefas da lista fixa por ordem de índice
+static void trabalhar_tarefas_ordenadas(ThreadArgs *t)
 {
-    int tabuleiro_int[9][9];
+    SolverContext *ctx = t->ctx;
+    Tarefa tarefa;
 
-    // Converter char* para int[][]
-    for (int i = 0; i < 81; i++)
+    while (!parado(ctx))
     {
-        tabuleiro_int[i / 9][i % 9] = tabuleiro[i] - '0';
+        int i = atomic_fetch_add(&ctx->proxima_tarefa, 1);
+        if (i >= ctx->num_tarefas_det || i > atomic_load(&ctx->melhor_tarefa))
+            break;
+
+        t->tarefa_atual = i;
+        tarefa = ctx->tarefas_det[i];
+        long nos_antes = t->nos;
+        t->tarefas_executadas++;
+        executar_tarefa(t, &tarefa);
+        ctx->nos_tarefa[i] = t->nos - nos_antes;
     }
+}
+
+// Trabalho de uma thread num jogo: executar/roubar tarefas até ao fim
+static void trabalhar_jogo(ThreadArgs *t)
+{
+    SolverContext *ctx = t->ctx;
+    char log_msg[256];
+    Tarefa tarefa;
+
+    snprintf(log_msg, sizeof(log_msg), ctx->semente ? "[Thread %d] A iniciar (tarefas por ordem, %d threads)"
+                                                    : "[Thread %d] A iniciar (work-stealing com %d threads)",
+             t->id, t->num_trabalhadores);
+    log_thread_safe(log_msg);
 
-    printf("[DEBUG] A iniciar Solver Paralelo (max %d threads) com Validação Remota...\n", global_num_threads);
+    // Ritmo de apresentação, só quando há servidor
+    if (ctx->ritmo && t->sockfd >= 0)
+        ritmo_aguardar(ctx->ritmo, &ctx->parar);
 
-    // CHAMADA AO SOLVER PARALELO com número de threads configurado
-    int result = resolver_sudoku_paralelo(tabuleiro_int, sockfd, idCliente, global_num_threads);
+    if (ctx->semente)
+        trabalhar_tarefas_ordenadas(t);
 
-    // Se resolveu, converter de volta
-    if (result)
+    while (!ctx->semente && !parado(ctx))
     {
-        for (int i = 0; i < 81; i++)
+        if (obter_tarefa(t, &tarefa))
         {
-            tabuleiro[i] = tabuleiro_int[i / 9][i % 9] + '0';
+            t->tarefas_executadas++;
+            executar_tarefa(t, &tarefa);
+            atomic_fetch_sub(&ctx->tarefas_pendentes, 1);
+            continue;
         }
-    }
+
+        // Sem trabalho visível: ficar ociosa até aparecer uma tarefa
+        // para roubar ou até não restar nenhuma pendente
+        atomic_fetch_add(&ctx->trabalhadores_ociosos, 1);
+        int encontrou = 0;
+        while (!parado(ctx) && atomic_load(&ctx->tarefas_pendentes) > 0)
+        {
+            if (obter_tarefa(t, &tarefa))
+            {
+                encontrou = 1;
+                break;
+            }
+            sched_yield();
+        }
+        atomic_fetch_sub(&ctx->trabalhadores_ociosos, 1);
+
+        if (!encontrou)
+            break;
+
+        t->tarefas_executadas++;
+        executar_tarefa(t, &tarefa);
+        atomic_fetch_sub(&ctx->tarefas_pendentes, 1);
+    }
+
+    const char *fim;
+    switch (atomic_load(&ctx->motivo))
+    {
+    case PARAGEM_SOLUCAO:
+        fim = "Solução encontrada.";
+        break;
+    case PARAGEM_CANCELADO:
+        fim = "Pesquisa cancelada.";
+        break;
+    case PARAGEM_PRAZO:
+        fim = "Prazo esgotado.";
+        break;
+    case PARAGEM_JOGO_TERMINADO:
+        fim = "Jogo terminado por outro cliente.";
+        break;
+    default:
+        fim = "Espaço de busca esgotado.";
+        break;
+    }
+
+    snprintf(log_msg, sizeof(log_msg), "[Thread %d] Terminou: %ld tarefas (%ld roubadas), %ld podas do oráculo. %s",
+             t->id, t->tarefas_executadas, t->tarefas_roubadas, t->podas_oraculo, fim);
+    log_thread_safe(log_msg);
+
+    atomic_fetch_add_explicit(&ctx->podas_oraculo, t->podas_oraculo, memory_order_relaxed);
+    atomic_fetch_add_explicit(&ctx->tt_acertos, t->tt_acertos, memory_order_relaxed);
+    atomic_fetch_add_explicit(&ctx->tt_falhas, t->tt_falhas, memory_order_relaxed);
+}
+
+static void *thread_pool(void *arg)
+{
+    ThreadArgs *t = (ThreadArgs *)arg;
+    SolverContext *ctx = t->ctx;
+    unsigned long geracao_vista = 0;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&ctx->mutex);
+        while (!ctx->a_terminar && ctx->geracao == geracao_vista)
+            pthread_cond_wait(&ctx->novo_jogo, &ctx->mutex);
+
+        if (ctx->a_terminar)
+        {
+            pthread_mutex_unlock(&ctx->mutex);
+            break;
+        }
+        geracao_vista = ctx->geracao;
+        pthread_mutex_unlock(&ctx->mutex);
+
+        trabalhar_jogo(t);
+
+        pthread_mutex_lock(&ctx->mutex);
+        if (--ctx->ativas == 0)
+            pthread_cond_signal(&ctx->jogo_terminado);
+        pthread_mutex_unlock(&ctx->mutex);
+    }
+
+    return NULL;
+}
+
+// Tamanho da tabela de transposição dos contextos novos (2^bits entradas, 0 = sem tabela)
+static int global_transposicao_bits = 18;
+
+// Semente dos contextos novos e do portfolio (0 = não determinístico)
+static unsigned int global_semente = 0;
+
+// Oráculo dos contextos novos (cortar com as recusas do servidor)
+static int global_oraculo = 0;
+
+// Ritmo de apresentação dos contextos novos
+static ModoRitmo global_ritmo = RITMO_DESLIGADO;
+static int global_ritmo_atraso_ms = 100;
+static int global_ritmo_por_segundo = 10;
+
+SolverContext *solver_contexto_criar(int numThreads)
+{
+    SolverContext *ctx = calloc(1, sizeof(SolverContext));
+    if (!ctx)
+        return NULL;
+
+    // Número de threads: configurado, ou uma por core (NUM_THREADS: 0)
+    int num_trabalhadores = numThreads;
+    if (num_trabalhadores <= 0)
+        num_trabalhadores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (num_trabalhadores < 1)
+        num_trabalhadores = 1;
+    if (num_trabalhadores > MAX_THREADS_SOLVER)
+        num_trabalhadores = MAX_THREADS_SOLVER;
+
+    atomic_init(&ctx->parar, 0);
+    atomic_init(&ctx->motivo, PARAGEM_NENHUMA);
+    atomic_init(&ctx->vencedor, 0);
+    atomic_init(&ctx->tarefas_pendentes, 0);
+    atomic_init(&ctx->trabalhadores_ociosos, 0);
+    atomic_init(&ctx->tt_acertos, 0);
+    atomic_init(&ctx->tt_falhas, 0);
+    atomic_init(&ctx->proxima_tarefa, 0);
+    atomic_init(&ctx->melhor_tarefa, INT_MAX);
+    ctx->semente = global_semente;
+    ctx->oraculo = global_oraculo;
+    atomic_init(&ctx->num_recusados, 0);
+    atomic_init(&ctx->podas_oraculo, 0);
+    ctx->tt = transposicao_criar(global_transposicao_bits);
+    ctx->ritmo = ritmo_criar(global_ritmo, global_ritmo_atraso_ms, global_ritmo_por_segundo);
+    pthread_mutex_init(&ctx->solucao_mutex, NULL);
+    pthread_mutex_init(&ctx->mutex, NULL);
+    pthread_mutex_init(&ctx->jogo_mutex, NULL);
+    pthread_cond_init(&ctx->novo_jogo, NULL);
+    pthread_cond_init(&ctx->jogo_terminado, NULL);
+
+    for (int i = 0; i < num_trabalhadores; i++)
+    {
+        pthread_mutex_init(&ctx->deques[ctx->num_threads].mutex, NULL);
+
+        ThreadArgs *t = &ctx->args[ctx->num_threads];
+        t->id = ctx->num_threads;
+        t->ctx = ctx;
+
+        // Criar thread
+        if (pthread_create(&ctx->threads[ctx->num_threads], NULL, thread_pool, t) == 0)
+        {
+            ctx->num_threads++;
+        }
+        else
+        {
+            pthread_mutex_destroy(&ctx->deques[ctx->num_threads].mutex);
+        }
+    }
+
+    printf("[POOL] %d/%d threads do solver prontas.\n", ctx->num_threads, num_trabalhadores);
+
+    if (ctx->num_threads == 0)
+    {
+        solver_contexto_destruir(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+void solver_contexto_destruir(SolverContext *ctx)
+{
+    if (!ctx)
+        return;
+
+    pthread_mutex_lock(&ctx->mutex);
+    ctx->a_terminar = 1;
+    pthread_cond_broadcast(&ctx->novo_jogo);
+    pthread_mutex_unlock(&ctx->mutex);
+
+    for (int i = 0; i < ctx->num_threads; i++)
+    {
+        pthread_join(ctx->threads[i], NULL);
+        pthread_mutex_destroy(&ctx->deques[i].mutex);
+    }
+    canal_validacao_destruir(ctx->canal);
+    ritmo_destruir(ctx->ritmo);
+
+    pthread_cond_destroy(&ctx->jogo_terminado);
+    pthread_cond_destroy(&ctx->novo_jogo);
+    pthread_mutex_destroy(&ctx->jogo_mutex);
+    pthread_mutex_destroy(&ctx->mutex);
+    pthread_mutex_destroy(&ctx->solucao_mutex);
+    transposicao_destruir(ctx->tt);
+    free(ctx);
+}
+
+void solver_contexto_cancelar(SolverContext *ctx)
+{
+    if (ctx)
+        contexto_parar(ctx, PARAGEM_CANCELADO);
+}
+
+void solver_contexto_definir_prazo(SolverContext *ctx, double segundos)
+{
+    ctx->prazo_segundos = segundos > 0 ? segundos : 0;
+}
+
+void solver_contexto_definir_semente(SolverContext *ctx, unsigned int semente)
+{
+    pthread_mutex_lock(&ctx->jogo_mutex);
+    ctx->semente = semente;
+    pthread_mutex_unlock(&ctx->jogo_mutex);
+}
+
+MotivoParagem solver_contexto_motivo(const SolverContext *ctx)
+{
+    return ctx ? (MotivoParagem)atomic_load(&ctx->motivo) : PARAGEM_NENHUMA;
+}
+
+int solver_contexto_vencedor(const SolverContext *ctx)
+{
+    return ctx ? atomic_load(&ctx->vencedor) : 0;
+}
+
+// Baralha candidatos[0..n) (Fisher-Yates com rand_r: sem estado global)
+static void baralhar_candidatos(int *candidatos, int n, unsigned int *semente)
+{
+    for (int i = n - 1; i > 0; i--)
+    {
+        int j = rand_r(semente) % (i + 1);
+        int temp = candidatos[i];
+        candidatos[i] = candidatos[j];
+        candidatos[j] = temp;
+    }
+}
+
+// Parte uma tarefa nas tarefas filhas (uma por candidato da célula
+// seguinte, por ordem baralhada). Devolve o número de filhas, 0 se a
+// tarefa for contraditória ou -1 se já estiver resolvida.
+static int expandir_tarefa(const Tarefa *tarefa, Tarefa *filhas, unsigned int *semente)
+{
+    Tarefa base = *tarefa;
+    TAB_CELULA(&base.tabuleiro, base.linha, base.coluna) = (uint8_t)base.numero;
+
+    MascarasSudoku m;
+    if (!mascaras_inicializar(&m, &base.tabuleiro))
+        return 0;
+
+    int trilho[81];
+    int n_trilho = 0;
+    if (global_propagacao && !propagar(&base.tabuleiro, &m, trilho, &n_trilho))
+        return 0;
+
+    ListaVazias vazias;
+    vazias_inicializar(&vazias, &base.tabuleiro);
+    int row, col;
+    int n = escolher_celula(&vazias, &m, global_heuristica, &row, &col);
+    if (n <= 0)
+        return n;
+
+    int candidatos[9];
+    uint16_t livres = mascaras_candidatos(&m, row, col);
+    n = 0;
+    while (livres)
+    {
+        candidatos[n++] = __builtin_ctz(livres) + 1;
+        livres &= livres - 1;
+    }
+    baralhar_candidatos(candidatos, n, semente);
+
+    for (int i = 0; i < n; i++)
+    {
+        filhas[i].tabuleiro = base.tabuleiro;
+        filhas[i].linha = row;
+        filhas[i].coluna = col;
+        filhas[i].numero = candidatos[i];
+        filhas[i].bandas_validadas = 0;
+    }
+    return n;
+}
+
+// Modo determinístico: expande as tarefas da raiz, por níveis e mantendo a
+// ordem da pesquisa em profundidade, até haver TAREFAS_DETERMINISTICAS
+// (ou deixar de ser possível)
+static void preparar_tarefas_ordenadas(SolverContext *ctx, unsigned int *semente)
+{
+    Tarefa *proximas = ctx->tarefas_det_aux;
+    int expandiu = 1;
+
+    while (ctx->num_tarefas_det < TAREFAS_DETERMINISTICAS && expandiu)
+    {
+        int n = 0;
+        expandiu = 0;
+        for (int i = 0; i < ctx->num_tarefas_det; i++)
+        {
+            Tarefa filhas[9];
+            int k = 0;
+            // Só se as filhas (e as tarefas que faltam) couberem na lista
+            if (n + 9 + (ctx->num_tarefas_det - i - 1) <= MAX_TAREFAS_DETERMINISTICAS)
+                k = expandir_tarefa(&ctx->tarefas_det[i], filhas, semente);
+            else
+                k = -1;
+
+            if (k < 0)
+                proximas[n++] = ctx->tarefas_det[i];
+            for (int j = 0; j < k; j++)
+                proximas[n++] = filhas[j];
+            if (k >= 0)
+                expandiu = 1;
+        }
+        memcpy(ctx->tarefas_det, proximas, (size_t)n * sizeof(Tarefa));
+        ctx->num_tarefas_det = n;
+    }
+}
+
+int resolver_sudoku_paralelo(SolverContext *ctx, Tabuleiro *tabuleiro_inicial, int sockfd, int idCliente)
+{
+    // 1. Construir as máscaras (pistas em conflito = impossível)
+    MascarasSudoku mascaras;
+    if (!mascaras_inicializar(&mascaras, tabuleiro_inicial))
+        return 0;
+
+    motor_sudoku_inicializar();
+
+    // Propagação na raiz: preenche já as células forçadas pelas pistas.
+    // As deduções ficam no tabuleiro (fazem parte de qualquer solução).
+    if (global_propagacao)
+    {
+        int trilho[81];
+        int n_trilho = 0;
+        if (!propagar(tabuleiro_inicial, &mascaras, trilho, &n_trilho))
+            return 0;
+
+        if (n_trilho > 0)
+        {
+            printf("[PROPAGACAO] %d células deduzidas na raiz.\n", n_trilho);
+        }
+    }
+
+    // 2. Escolher a célula onde ramificar (mesma heurística das threads)
+    ListaVazias vazias;
+    vazias_inicializar(&vazias, tabuleiro_inicial);
+
+    int row = -1, col = -1;
+    int num_candidatos = escolher_celula(&vazias, &mascaras, global_heuristica, &row, &col);
+
+    // Se já estiver resolvido (sem zeros)
+    if (num_candidatos < 0)
+        return 1;
+
+    // Se não há candidatos válidos, impossível resolver
+    if (num_candidatos == 0)
+        return 0;
+
+    uint16_t livres = mascaras_candidatos(&mascaras, row, col);
+    int candidatos[9];
+    num_candidatos = 0;
+
+    while (livres)
+    {
+        candidatos[num_candidatos++] = __builtin_ctz(livres) + 1;
+        livres &= livres - 1;
+    }
+
+    pthread_mutex_lock(&ctx->jogo_mutex);
+    unsigned int semente_jogo = ctx->semente;
+
+    // 3. PID-BASED SHUFFLE: Embaralhar ordem dos candidatos baseado no PID
+    // Isto garante que diferentes clientes exploram em ordens diferentes
+    pid_t pid = getpid();
+    
+    // MELHORAR ENTROPIA: combinar PID + tempo + endereço de memória.
+    // No modo determinístico a ordem vem só da semente.
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    unsigned int seed = semente_jogo ? semente_jogo : (unsigned int)(pid ^ ts.tv_nsec ^ ((uintptr_t)&seed >> 4));
+
+    baralhar_candidatos(candidatos, num_candidatos, &seed);
+
+    if (semente_jogo)
+        printf("[SHUFFLE] Semente=%u: Ordem embaralhada: ", semente_jogo);
+    else
+        printf("[SHUFFLE] PID=%d: Ordem embaralhada: ", pid);
+    for (int i = 0; i < num_candidatos; i++)
+    {
+        printf("%d ", candidatos[i]);
+    }
+    printf("\n");
+
+    int num_threads = ctx->num_threads;
+
+    // 4. Reiniciar o estado do contexto para este jogo. O jogo anterior
+    // pode ter acabado com tarefas por explorar: descartá-las.
+    atomic_store(&ctx->parar, 0);
+    atomic_store(&ctx->motivo, PARAGEM_NENHUMA);
+    atomic_store(&ctx->vencedor, 0);
+    ctx->tem_solucao = 0;
+    memset(ctx->recusados, 0, sizeof(ctx->recusados)); // A thread de E/S está parada entre jogos
+    atomic_store(&ctx->num_recusados, 0);
+    atomic_store(&ctx->podas_oraculo, 0);
+    if (sockfd >= 0)
+    {
+        if (!ctx->canal)
+            ctx->canal = canal_validacao_criar(canal_jogo_terminado, canal_unidades_recusadas, ctx);
+        if (ctx->canal)
+            canal_validacao_iniciar_jogo(ctx->canal, sockfd, idCliente);
+    }
+    if (ctx->prazo_segundos > 0)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &ctx->prazo);
+        long long ns = ctx->prazo.tv_nsec + (long long)((ctx->prazo_segundos - (long)ctx->prazo_segundos) * 1e9);
+        ctx->prazo.tv_sec += (long)ctx->prazo_segundos + ns / 1000000000LL;
+        ctx->prazo.tv_nsec = ns % 1000000000LL;
+    }
+
+    atomic_store(&ctx->tarefas_pendentes, 0);
+    atomic_store(&ctx->trabalhadores_ociosos, 0);
+    for (int i = 0; i < num_threads; i++)
+    {
+        ctx->deques[i].topo = 0;
+        ctx->deques[i].n = 0;
+    }
+
+    // 5. Distribuir as tarefas da raiz pelas deques (ordem embaralhada)
+    Tarefa tarefa;
+    tarefa.tabuleiro = *tabuleiro_inicial;
+    tarefa.linha = row;
+    tarefa.coluna = col;
+    tarefa.bandas_validadas = 0;
+    if (semente_jogo)
+    {
+        // Modo determinístico: lista fixa, tirada por ordem pelas threads
+        for (int i = 0; i < num_candidatos; i++)
+        {
+            tarefa.numero = candidatos[i];
+            ctx->tarefas_det[i] = tarefa;
+        }
+        ctx->num_tarefas_det = num_candidatos;
+        preparar_tarefas_ordenadas(ctx, &seed);
+
+        memset(ctx->nos_tarefa, 0, sizeof(ctx->nos_tarefa));
+        atomic_store(&ctx->proxima_tarefa, 0);
+        atomic_store(&ctx->melhor_tarefa, INT_MAX);
+    }
+    for (int i = 0; !semente_jogo && i < num_candidatos; i++)
+    {
+        tarefa.numero = candidatos[i];
+        atomic_fetch_add(&ctx->tarefas_pendentes, 1);
+        deque_empilhar(&ctx->deques[i % num_threads], &tarefa);
+    }
+
+    // 6. Entregar o jogo ao pool e esperar que todas as threads terminem
+    pthread_mutex_lock(&ctx->mutex);
+    for (int i = 0; i < num_threads; i++)
+    {
+        ctx->args[i].sockfd = sockfd;         // Passar socket
+        ctx->args[i].idCliente = idCliente;   // Passar ID
+        ctx->args[i].num_trabalhadores = num_threads;
+        ctx->args[i].tarefas_executadas = 0;
+        ctx->args[i].tarefas_roubadas = 0;
+        ctx->args[i].nos = 0;
+        ctx->args[i].tt_acertos = 0;
+        ctx->args[i].tt_falhas = 0;
+        ctx->args[i].podas_oraculo = 0;
+        memset(ctx->args[i].chaves_validadas, 0, sizeof(ctx->args[i].chaves_validadas));
+    }
+    ctx->ativas = num_threads;
+    ctx->geracao++;
+    pthread_cond_broadcast(&ctx->novo_jogo);
+
+    printf("[PARALELO] %d threads do pool, %d tarefas iniciais na célula (%d, %d).\n",
+           num_threads, semente_jogo ? ctx->num_tarefas_det : num_candidatos, row, col);
+
+    while (ctx->ativas > 0)
+        pthread_cond_wait(&ctx->jogo_terminado, &ctx->mutex);
+    pthread_mutex_unlock(&ctx->mutex);
+
+    ctx->last_num_threads = num_threads; // Guardar contagem
+
+    if (semente_jogo)
+    {
+        // Nós das tarefas até à vencedora (todas acabaram): não dependem
+        // do número de threads nem do escalonamento
+        int melhor = atomic_load(&ctx->melhor_tarefa);
+        int ultima = melhor == INT_MAX ? ctx->num_tarefas_det - 1 : melhor;
+        long nos = 0;
+        for (int i = 0; i <= ultima; i++)
+            nos += ctx->nos_tarefa[i];
+
+        char log_msg[200];
+        if (melhor == INT_MAX)
+            snprintf(log_msg, sizeof(log_msg), "[DETERMINISTICO] Semente %u: %d tarefas, sem solução, %ld nós.",
+                     semente_jogo, ctx->num_tarefas_det, nos);
+        else
+            snprintf(log_msg, sizeof(log_msg), "[DETERMINISTICO] Semente %u: solução na tarefa %d de %d, %ld nós.",
+                     semente_jogo, melhor, ctx->num_tarefas_det, nos);
+        printf("%s\n", log_msg);
+        log_thread_safe(log_msg);
+
+        if (ctx->tem_solucao)
+            contexto_parar(ctx, PARAGEM_SOLUCAO);
+    }
+
+    // Esperar pelas respostas das validações em voo: a seguir o socket volta
+    // a ser só do str_cli. Um JOGO_TERMINADO conta mesmo que já haja solução,
+    // porque o servidor fechou a ligação deste jogo.
+    if (sockfd >= 0 && ctx->canal)
+    {
+        canal_validacao_terminar_jogo(ctx->canal);
+        if (oraculo_ativo(ctx))
+            printf("[ORACULO] %d unidades recusadas pelo servidor, %ld subárvores cortadas.\n",
+                   atomic_load(&ctx->num_recusados), atomic_load(&ctx->podas_oraculo));
+        if (atomic_load(&ctx->vencedor))
+        {
+            atomic_store(&ctx->motivo, PARAGEM_JOGO_TERMINADO);
+            ctx->tem_solucao = 0;
+        }
+    }
+
+    if (ctx->tt)
+    {
+        long acertos = atomic_load(&ctx->tt_acertos);
+        long consultas = acertos + atomic_load(&ctx->tt_falhas);
+        printf("[TT] Acumulado: %ld acertos em %ld consultas (%.1f%%), %ld/%ld entradas ocupadas.\n",
+               acertos, consultas, consultas ? 100.0 * acertos / consultas : 0.0,
+               transposicao_ocupadas(ctx->tt), transposicao_capacidade(ctx->tt));
+    }
+
+    // 7. Verificar se alguma encontrou a solução
+    int resolvido = ctx->tem_solucao;
+    if (resolvido)
+        *tabuleiro_inicial = ctx->tabuleiro_solucao;
+
+    pthread_mutex_unlock(&ctx->jogo_mutex);
+    return resolvido;
+}
+
+int resolver_sudoku_sequencial(Tabuleiro *tabuleiro)
+{
+    MascarasSudoku mascaras;
+    if (!mascaras_inicializar(&mascaras, tabuleiro))
+        return 0;
+
+    motor_sudoku_inicializar();
+
+    // Mesmo motor das threads do pool, mas sem contexto: sem doações,
+    // sem cancelamento e sem validação remota (sockfd = -1)
+    ThreadArgs t;
+    memset(&t, 0, sizeof(t));
+    t.sockfd = -1;
+
+    Tabuleiro trabalho = *tabuleiro;
+    int trilho[81];
+    int n_trilho = 0;
+    int bandas_validadas = 0;
+
+    if (global_propagacao && !propagar(&trabalho, &mascaras, trilho, &n_trilho))
+        return 0;
+
+    if (!resolver_sudoku_sequencial_int(&trabalho, &mascaras, &t, &bandas_validadas))
+        return 0;
+
+    *tabuleiro = trabalho;
+    return 1;
+}
+
+// Variável global para armazenar a config (será setada pelo main)
+static int global_num_threads = 9;
+
+// ---------------------------------------------------------------------
+// Resolução em lote: cada thread avança global_lote_intercalados pesquisas
+// à vez, um passo de cada, em vez de levar uma de cada vez até ao fim. Os
+// passos de tabuleiros diferentes não dependem uns dos outros, pelo que o
+// CPU pode sobrepor as suas latências. Quando um tabuleiro termina, o seu
+// lugar recebe o seguinte do lote.
+//
+// Nota: com o motor atual cada passo já inclui a propagação (trabalho
+// longo e com bom uso de cache), e numa máquina de um core intercalar 8
+// chegou a ser ~10% mais lento do que 1. Por isso o valor por omissão é 1
+// e o ganho principal vem de usar todos os cores sem o pool por jogo.
+// ---------------------------------------------------------------------
+#define MAX_LOTE_INTERCALADOS 16
+
+static int global_lote_intercalados = 1;
+
+typedef struct
+{
+    Tabuleiro *tabuleiros;
+    int *resultados;
+    int n;
+    atomic_int proximo;    // Próximo tabuleiro por distribuir
+    atomic_int resolvidos;
+} TrabalhoLote;
+
+typedef struct
+{
+    int indice; // Tabuleiro em curso (-1 = lugar livre)
+    Tabuleiro trabalho;
+    MascarasSudoku mascaras;
+    Pesquisa pesquisa;
+    int bandas_validadas;
+} LugarLote;
+
+static void lote_terminar(TrabalhoLote *w, LugarLote *l, int resolvido)
+{
+    if (resolvido)
+    {
+        w->tabuleiros[l->indice] = l->trabalho;
+        atomic_fetch_add_explicit(&w->resolvidos, 1, memory_order_relaxed);
+    }
+    if (w->resultados)
+        w->resultados[l->indice] = resolvido;
+}
+
+// Ocupa o lugar com o próximo tabuleiro por resolver. Os que ficam
+// resolvidos (ou se revelam impossíveis) logo na raiz terminam aqui.
+// Devolve 0 quando o lote se esgotou.
+static int lote_preencher(TrabalhoLote *w, LugarLote *l)
+{
+    for (;;)
+    {
+        int i = atomic_fetch_add_explicit(&w->proximo, 1, memory_order_relaxed);
+        if (i >= w->n)
+        {
+            l->indice = -1;
+            return 0;
+        }
+
+        l->indice = i;
+        l->trabalho = w->tabuleiros[i];
+        l->bandas_validadas = 0;
+
+        int consistente = mascaras_inicializar(&l->mascaras, &l->trabalho);
+        if (consistente && global_propagacao)
+        {
+            int trilho[81];
+            int n_trilho = 0;
+            consistente = propagar(&l->trabalho, &l->mascaras, trilho, &n_trilho);
+        }
+
+        if (!consistente)
+        {
+            lote_terminar(w, l, 0);
+            continue;
+        }
+
+        pesquisa_iniciar(&l->pesquisa, &l->trabalho, &l->mascaras);
+        return 1;
+    }
+}
+
+static void *trabalhar_lote(void *arg)
+{
+    TrabalhoLote *w = (TrabalhoLote *)arg;
+    LugarLote lugares[MAX_LOTE_INTERCALADOS];
+    int intercalados = global_lote_intercalados;
+
+    // Sem contexto: sem doações, sem cancelamento e sem validação remota
+    ThreadArgs t;
+    memset(&t, 0, sizeof(t));
+    t.sockfd = -1;
+
+    int ativos = 0;
+    for (int k = 0; k < intercalados; k++)
+        ativos += lote_preencher(w, &lugares[k]);
+
+    while (ativos > 0)
+    {
+        for (int k = 0; k < intercalados; k++)
+        {
+            LugarLote *l = &lugares[k];
+            if (l->indice < 0)
+                continue;
+
+            EstadoPesquisa estado = pesquisa_passo(&l->pesquisa, &t, &l->bandas_validadas);
+            if (estado == PESQUISA_A_CORRER)
+                continue;
+
+            lote_terminar(w, l, estado == PESQUISA_RESOLVIDA);
+            if (!lote_preencher(w, l))
+                ativos--;
+        }
+    }
+
+    return NULL;
+}
+
+void set_global_lote_intercalados(int n)
+{
+    if (n < 1)
+        n = 1;
+    if (n > MAX_LOTE_INTERCALADOS)
+        n = MAX_LOTE_INTERCALADOS;
+    global_lote_intercalados = n;
+}
+
+int resolver_sudoku_lote(Tabuleiro *tabuleiros, int *resultados, int n, int numThreads, EstatisticasLote *estatisticas)
+{
+    if (n < 0)
+        n = 0;
+
+    motor_sudoku_inicializar();
+
+    int num_trabalhadores = numThreads;
+    if (num_trabalhadores <= 0)
+        num_trabalhadores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (num_trabalhadores > MAX_THREADS_SOLVER)
+        num_trabalhadores = MAX_THREADS_SOLVER;
+    // Não vale a pena criar threads que ficariam sem tabuleiros
+    if (num_trabalhadores > n)
+        num_trabalhadores = n;
+    if (num_trabalhadores < 1)
+        num_trabalhadores = 1;
+
+    TrabalhoLote w;
+    w.tabuleiros = tabuleiros;
+    w.resultados = resultados;
+    w.n = n;
+    atomic_init(&w.proximo, 0);
+    atomic_init(&w.resolvidos, 0);
+
+    struct timespec inicio, fim;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+
+    // A thread que chama também trabalha
+    pthread_t threads[MAX_THREADS_SOLVER];
+    int criadas = 0;
+    for (int i = 1; i < num_trabalhadores; i++)
+    {
+        if (pthread_create(&threads[criadas], NULL, trabalhar_lote, &w) != 0)
+            break;
+        criadas++;
+    }
+    trabalhar_lote(&w);
+    for (int i = 0; i < criadas; i++)
+        pthread_join(threads[i], NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+
+    int resolvidos = atomic_load(&w.resolvidos);
+    if (estatisticas)
+    {
+        estatisticas->total = n;
+        estatisticas->resolvidos = resolvidos;
+        estatisticas->threads = criadas + 1;
+        estatisticas->segundos = (double)(fim.tv_sec - inicio.tv_sec) + (double)(fim.tv_nsec - inicio.tv_nsec) / 1e9;
+        estatisticas->puzzles_por_segundo = estatisticas->segundos > 0 ? n / estatisticas->segundos : 0.0;
+    }
+
+    return resolvidos;
+}
+
+// ---------------------------------------------------------------------
+// Portfolio: a mesma instância entregue a estratégias diferentes, cada uma
+// na sua thread. Alguns puzzles são muito lentos para uma estratégia e
+// triviais para outra (tempos de cauda pesada); correr várias em paralelo
+// e ficar com a primeira resposta limita o pior caso ao da mais rápida.
+// Um membro completo que esgota a pesquisa também responde: não há solução.
+// ---------------------------------------------------------------------
+#define REINICIO_NOS_INICIAL 256 // Nós da primeira tentativa (duplica a cada reinício)
+
+typedef struct Portfolio Portfolio;
+
+typedef enum
+{
+    MEMBRO_SEM_RESPOSTA = 0, // Cancelado ou parou por um limite: não prova nada
+    MEMBRO_RESOLVIDO = 1,
+    MEMBRO_SEM_SOLUCAO = 2   // Pesquisa completa esgotada: o puzzle não tem solução
+} ResultadoMembro;
+
+typedef struct
+{
+    const char *nome;
+    ResultadoMembro (*resolver)(Portfolio *pf, Tabuleiro *tabuleiro);
+} MembroPortfolio;
+
+struct Portfolio
+{
+    Tabuleiro inicial;
+    atomic_int parar; // Ligado pelo primeiro membro a responder
+    pthread_mutex_t mutex;
+    int vencedor;     // Índice do membro que respondeu (-1 = nenhum)
+    int sem_solucao;  // 1 = a resposta foi "não há solução"
+    Tabuleiro solucao;
+};
+
+typedef struct
+{
+    Portfolio *pf;
+    int indice;
+} ArgsMembro;
+
+// Backtracking do motor principal com a estratégia dada
+static int portfolio_backtracking(Portfolio *pf, Tabuleiro *tabuleiro, HeuristicaCelula heuristica,
+                                  int propagacao, unsigned int *semente, long limite_nos, int *esgotou)
+{
+    MascarasSudoku mascaras;
+    *esgotou = 1;
+    if (!mascaras_inicializar(&mascaras, tabuleiro))
+        return 0;
+
+    int trilho[81];
+    int n_trilho = 0;
+    if (propagacao && !propagar(tabuleiro, &mascaras, trilho, &n_trilho))
+        return 0;
+
+    ThreadArgs t;
+    memset(&t, 0, sizeof(t));
+    t.sockfd = -1;
+    t.cancelar = &pf->parar;
+
+    Pesquisa p;
+    pesquisa_iniciar(&p, tabuleiro, &mascaras);
+    p.heuristica = heuristica;
+    p.propagacao = propagacao;
+    p.semente = semente;
+
+    int bandas_validadas = 0;
+    long passos = 0;
+    EstadoPesquisa estado;
+    while ((estado = pesquisa_passo(&p, &t, &bandas_validadas)) == PESQUISA_A_CORRER)
+    {
+        if (limite_nos > 0 && ++passos >= limite_nos)
+        {
+            *esgotou = 0; // Parou pelo limite, não por falta de solução
+            return 0;
+        }
+    }
+
+    return estado == PESQUISA_RESOLVIDA;
+}
+
+// Resultado de um membro completo (sem limite de nós): sem solução e sem
+// ter sido cancelado, a pesquisa esgotou-se
+static ResultadoMembro resultado_completo(Portfolio *pf, int resolvido)
+{
+    if (resolvido)
+        return MEMBRO_RESOLVIDO;
+    if (atomic_load(&pf->parar))
+        return MEMBRO_SEM_RESPOSTA;
+    return MEMBRO_SEM_SOLUCAO;
+}
+
+static ResultadoMembro membro_mrv(Portfolio *pf, Tabuleiro *tabuleiro)
+{
+    int esgotou;
+    return resultado_completo(pf, portfolio_backtracking(pf, tabuleiro, HEURISTICA_MRV, 1, NULL, 0, &esgotou));
+}
+
+static ResultadoMembro membro_dlx(Portfolio *pf, Tabuleiro *tabuleiro)
+{
+    return resultado_completo(pf, resolver_sudoku_dlx_cancelavel(tabuleiro, &pf->parar));
+}
+
+// Só conta quando resolve: a prova de que não há solução fica para os
+// restantes membros completos
+static ResultadoMembro membro_bitboard(Portfolio *pf, Tabuleiro *tabuleiro)
+{
+    return resolver_sudoku_bitboard_cancelavel(tabuleiro, &pf->parar) ? MEMBRO_RESOLVIDO : MEMBRO_SEM_RESPOSTA;
+}
+
+// Ordem aleatória dos candidatos com um limite de nós que duplica a cada
+// reinício: um mau começo custa no máximo o limite da tentativa atual
+static ResultadoMembro membro_reinicios(Portfolio *pf, Tabuleiro *tabuleiro)
+{
+    unsigned int semente = global_semente ? global_semente
+                                          : (unsigned int)time(NULL) ^ (unsigned int)getpid() ^ (unsigned int)(uintptr_t)tabuleiro;
+    long limite = REINICIO_NOS_INICIAL;
+
+    while (!atomic_load_explicit(&pf->parar, memory_order_relaxed))
+    {
+        Tabuleiro trabalho = pf->inicial;
+        int esgotou;
+        if (portfolio_backtracking(pf, &trabalho, HEURISTICA_MRV, 1, &semente, limite, &esgotou))
+        {
+            *tabuleiro = trabalho;
+            return MEMBRO_RESOLVIDO;
+        }
+        if (esgotou)
+            return resultado_completo(pf, 0); // Árvore inteira explorada dentro do limite
+
+        limite *= 2;
+    }
+    return MEMBRO_SEM_RESPOSTA;
+}
+
+static ResultadoMembro membro_sat(Portfolio *pf, Tabuleiro *tabuleiro)
+{
+    return resultado_completo(pf, resolver_sudoku_sat_cancelavel(tabuleiro, &pf->parar));
+}
+
+static const MembroPortfolio membros_portfolio[] = {
+    {"MRV + propagação", membro_mrv},
+    {"DLX", membro_dlx},
+    {"bitboard", membro_bitboard},
+    {"reinícios aleatórios", membro_reinicios},
+    {"CDCL", membro_sat},
+};
+
+#define NUM_MEMBROS_PORTFOLIO ((int)(sizeof(membros_portfolio) / sizeof(membros_portfolio[0])))
+
+static void *thread_membro(void *arg)
+{
+    ArgsMembro *a = (ArgsMembro *)arg;
+    Portfolio *pf = a->pf;
+    Tabuleiro trabalho = pf->inicial;
+
+    ResultadoMembro resultado = membros_portfolio[a->indice].resolver(pf, &trabalho);
+    if (resultado == MEMBRO_SEM_RESPOSTA)
+        return NULL;
+
+    pthread_mutex_lock(&pf->mutex);
+    if (pf->vencedor < 0)
+    {
+        pf->vencedor = a->indice;
+        pf->sem_solucao = resultado == MEMBRO_SEM_SOLUCAO;
+        pf->solucao = trabalho;
+        atomic_store(&pf->parar, 1); // Cancelar os restantes
+    }
+    pthread_mutex_unlock(&pf->mutex);
+    return NULL;
+}
+
+int resolver_sudoku_portfolio(Tabuleiro *tabuleiro, const char **vencedor)
+{
+    motor_sudoku_inicializar();
+
+    Portfolio pf;
+    pf.inicial = *tabuleiro;
+    atomic_init(&pf.parar, 0);
+    pthread_mutex_init(&pf.mutex, NULL);
+    pf.vencedor = -1;
+    pf.sem_solucao = 0;
+
+    pthread_t threads[NUM_MEMBROS_PORTFOLIO];
+    ArgsMembro args[NUM_MEMBROS_PORTFOLIO];
+    int criada[NUM_MEMBROS_PORTFOLIO];
+
+    for (int i = 0; i < NUM_MEMBROS_PORTFOLIO; i++)
+    {
+        args[i].pf = &pf;
+        args[i].indice = i;
+        criada[i] = pthread_create(&threads[i], NULL, thread_membro, &args[i]) == 0;
+        if (!criada[i])
+            thread_membro(&args[i]); // Sem threads: correr aqui, por ordem
+    }
+
+    // Os membros cancelados saem no nó seguinte
+    for (int i = 0; i < NUM_MEMBROS_PORTFOLIO; i++)
+    {
+        if (criada[i])
+            pthread_join(threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&pf.mutex);
+
+    if (vencedor)
+        *vencedor = pf.vencedor >= 0 ? membros_portfolio[pf.vencedor].nome : NULL;
+    if (pf.vencedor < 0 || pf.sem_solucao)
+        return 0;
+
+    *tabuleiro = pf.solucao;
+    return 1;
+}
+
+void set_global_tabela_transposicao(int bits)
+{
+    global_transposicao_bits = bits > 0 ? bits : 0;
+}
+
+void set_global_semente(unsigned int semente)
+{
+    global_semente = semente;
+}
+
+void set_global_oraculo(int ativo)
+{
+    global_oraculo = ativo;
+}
+
+void set_global_ritmo(ModoRitmo modo, int atraso_ms, int por_segundo)
+{
+    global_ritmo = modo;
+    global_ritmo_atraso_ms = atraso_ms;
+    global_ritmo_por_segundo = por_segundo;
+}
+
+void set_global_num_threads(int num)
+{
+    global_num_threads = num;
+}
+
+// Motor de resolução (setado pelo main a partir da config)
+static MotorSolver global_motor = MOTOR_BACKTRACKING;
+
+void set_global_motor(MotorSolver motor)
+{
+    global_motor = motor;
+}
+
+// Contexto usado pelo resolver_sudoku() (o pool do cliente)
+static SolverContext *contexto_global = NULL;
+static pthread_mutex_t contexto_global_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+int iniciar_pool_solver(int numThreads)
+{
+    pthread_mutex_lock(&contexto_global_mutex);
+    if (!contexto_global)
+        contexto_global = solver_contexto_criar(numThreads);
+    int num_threads = contexto_global ? contexto_global->num_threads : 0;
+    pthread_mutex_unlock(&contexto_global_mutex);
+    return num_threads;
+}
+
+void terminar_pool_solver(void)
+{
+    pthread_mutex_lock(&contexto_global_mutex);
+    solver_contexto_destruir(contexto_global);
+    contexto_global = NULL;
+    pthread_mutex_unlock(&contexto_global_mutex);
+}
+
+SolverContext *solver_contexto_global(void)
+{
+    return contexto_global;
+}
+
+int get_num_threads_last_run()
+{
+    // DLX e bitboard resolvem numa só thread; o portfolio usa uma por membro
+    if (global_motor == MOTOR_PORTFOLIO)
+        return NUM_MEMBROS_PORTFOLIO;
+    if (global_motor != MOTOR_BACKTRACKING)
+        return 1;
+    return contexto_global ? contexto_global->last_num_threads : 0;
+}
+
+// Tamanho da codificação e trabalho do CDCL, para comparar jogos
+static void registar_estatisticas_sat(const EstatisticasSat *est)
+{
+    char log_msg[200];
+    snprintf(log_msg, sizeof(log_msg),
+             "[SAT] %d variáveis, %d cláusulas, %ld decisões, %ld conflitos, %ld aprendidas, %ld reinícios",
+             est->variaveis, est->clausulas, est->decisoes, est->conflitos, est->aprendidas, est->reinicios);
+    printf("%s\n", log_msg);
+    log_thread_safe(log_msg);
+}
+
+int resolver_sudoku(Tabuleiro *tabuleiro, int sockfd, int idCliente)
+{
+    int result;
+
+    if (global_motor == MOTOR_DLX)
+    {
+        printf("[DEBUG] A iniciar Solver DLX (Dancing Links)...\n");
+
+        result = resolver_sudoku_dlx(tabuleiro);
+    }
+    else if (global_motor == MOTOR_BITBOARD)
+    {
+        printf("[DEBUG] A iniciar Solver Bitboard (kernel %s)...\n", bitboard_kernel_ativo());
+
+        result = resolver_sudoku_bitboard(tabuleiro);
+    }
+    else if (global_motor == MOTOR_SAT)
+    {
+        printf("[DEBUG] A iniciar Solver SAT (CDCL)...\n");
+
+        EstatisticasSat est;
+        result = resolver_grelha_sat(tabuleiro->celulas, 3, NULL, &est);
+        registar_estatisticas_sat(&est);
+    }
+    else if (global_motor == MOTOR_PORTFOLIO)
+    {
+        printf("[DEBUG] A iniciar Solver Portfolio (%d estratégias em corrida)...\n", NUM_MEMBROS_PORTFOLIO);
+
+        const char *vencedor = NULL;
+        result = resolver_sudoku_portfolio(tabuleiro, &vencedor);
+
+        if (vencedor)
+        {
+            char log_msg[128];
+            snprintf(log_msg, sizeof(log_msg), result ? "[PORTFOLIO] Venceu: %s" : "[PORTFOLIO] %s provou que não há solução", vencedor);
+            printf("%s\n", log_msg);
+            log_thread_safe(log_msg);
+        }
+    }
+    else
+    {
+        // Pool normalmente já iniciado pelo main
+        if (iniciar_pool_solver(global_num_threads) == 0)
+            return 0;
+
+        printf("[DEBUG] A iniciar Solver Paralelo (%d threads) com Validação Remota...\n", contexto_global->num_threads);
+
+        // CHAMADA AO SOLVER PARALELO no contexto do cliente
+        result = resolver_sudoku_paralelo(contexto_global, tabuleiro, sockfd, idCliente);
+    }
 
     return result;
 }
 
+int resolver_sudoku_recurso(Tabuleiro *tabuleiro, const char **motor)
+{
+    if (global_motor == MOTOR_DLX)
+    {
+        *motor = "Bitboard";
+        return resolver_sudoku_bitboard(tabuleiro);
+    }
+    *motor = "DLX";
+    return resolver_sudoku_dlx(tabuleiro);
+}
+
+int resolver_sudoku_nxn(TabuleiroNxN *tabuleiro, int bloco)
+{
+    int lado = nxn_lado(bloco);
+
+    if (global_motor == MOTOR_SAT)
+    {
+        printf("[DEBUG] A iniciar Solver SAT (CDCL, %dx%d)...\n", lado, lado);
+
+        EstatisticasSat est;
+        int result = resolver_grelha_sat(tabuleiro->celulas, bloco, NULL, &est);
+        registar_estatisticas_sat(&est);
+        return result;
+    }
+
+    printf("[DEBUG] A iniciar Solver N×N (%dx%d)...\n", lado, lado);
+
+    TabuleiroNxN solucao;
+    if (nxn_contar_solucoes(tabuleiro, bloco, 1, &solucao, 0, NULL) != 1)
+        return 0;
+
+    memcpy(tabuleiro->celulas, solucao.celulas, nxn_celulas(bloco));
+    return 1;
+}
+
+int resolver_sudoku_nxn_recurso(TabuleiroNxN *tabuleiro, int bloco, const char **motor)
+{
+    if (global_motor != MOTOR_SAT)
+    {
+        *motor = "CDCL";
+        return resolver_grelha_sat(tabuleiro->celulas, bloco, NULL, NULL);
+    }
+
+    *motor = "núcleo N×N";
+    TabuleiroNxN solucao;
+    if (nxn_contar_solucoes(tabuleiro, bloco, 1, &solucao, 0, NULL) != 1)
+        return 0;
+    memcpy(tabuleiro->celulas, solucao.celulas, nxn_celulas(bloco));
+    return 1;
+}
+
 // --- Código antigo (mantido mas não usado diretamente pelo wrapper agora) ---
 
 static int eh_valido(const char *tabuleiro, int pos, char num)
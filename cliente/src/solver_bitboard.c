@@ -0,0 +1,352 @@
+// cliente/src/solver_bitboard.c - Solver de Sudoku por bitboards de dígitos (SIMD)
+//
+// O tabuleiro é guardado como 9 bitboards de 81 bits, um por dígito, cada
+// um num registo de 128 bits: o bit i de cand[d] está ligado se o dígito
+// d+1 ainda pode ir para a célula i. Eliminação de pares e deteção de
+// singles passam a ser AND/OR/ANDNOT sobre registos inteiros.
+//
+// O núcleo (solver_bitboard_kernel.h) é compilado três vezes - escalar,
+// SSE2 e AVX2 - e a versão usada é escolhida em runtime pelo CPUID.
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "solver_bitboard.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define BITBOARD_X86 1
+#endif
+
+// 81 bits: células 0-63 em 'lo', 64-80 em 'hi'
+typedef struct
+{
+    uint64_t lo;
+    uint64_t hi;
+} __attribute__((aligned(16))) Lane;
+
+// Alinhado a 32 bytes para o AVX2 ler pares de dígitos (cand[0..7]) de uma vez
+typedef struct
+{
+    Lane cand[9];      // Onde cada dígito ainda pode ser colocado
+    Lane colocados[9]; // Onde cada dígito já foi colocado
+    Lane vazias;       // Células por preencher
+} __attribute__((aligned(32))) EstadoBitboard;
+
+typedef struct
+{
+    const char *nome;
+    void (*colocar)(EstadoBitboard *e, int celula, int d);
+    int (*pesquisar)(EstadoBitboard *e, const atomic_int *parar);
+} KernelBitboard;
+
+// Tabelas pré-calculadas (iguais para todos os kernels)
+static Lane bb_celula[81];    // Bit da própria célula
+static Lane bb_pares[81];     // Linha + coluna + bloco da célula
+static Lane bb_unidades[27];  // 9 linhas, 9 colunas, 9 blocos
+static Lane bb_todas;         // As 81 células
+
+static inline void lane_ligar(Lane *l, int celula)
+{
+    if (celula < 64)
+        l->lo |= 1ULL << celula;
+    else
+        l->hi |= 1ULL << (celula - 64);
+}
+
+static inline int lane_testar(const Lane *l, int celula)
+{
+    return celula < 64 ? (int)((l->lo >> celula) & 1) : (int)((l->hi >> (celula - 64)) & 1);
+}
+
+static inline int lane_vazio(const Lane *l)
+{
+    return (l->lo | l->hi) == 0;
+}
+
+// Retira e devolve o índice do bit mais baixo (a lane não pode estar vazia)
+static inline int lane_extrair(Lane *l)
+{
+    if (l->lo)
+    {
+        int celula = __builtin_ctzll(l->lo);
+        l->lo &= l->lo - 1;
+        return celula;
+    }
+    int celula = 64 + __builtin_ctzll(l->hi);
+    l->hi &= l->hi - 1;
+    return celula;
+}
+
+// ---------------------------------------------------------------------------
+// Kernel escalar (fallback portátil): dois uint64_t por registo
+// ---------------------------------------------------------------------------
+
+static inline Lane lane_and(Lane a, Lane b) { return (Lane){a.lo & b.lo, a.hi & b.hi}; }
+static inline Lane lane_or(Lane a, Lane b) { return (Lane){a.lo | b.lo, a.hi | b.hi}; }
+static inline Lane lane_andnot(Lane a, Lane b) { return (Lane){a.lo & ~b.lo, a.hi & ~b.hi}; }
+
+#define K_SUFIXO escalar
+#define K_NOME_TEXTO "escalar"
+#define K_ATRIBUTO
+#define K_V Lane
+#define K_CARREGAR(p) (*(p))
+#define K_GUARDAR(p, v) (*(p) = (v))
+#define K_AND(a, b) lane_and((a), (b))
+#define K_OR(a, b) lane_or((a), (b))
+#define K_ANDNOT(a, b) lane_andnot((a), (b))
+#define K_ZERO() ((Lane){0, 0})
+#define K_E_ZERO(v) lane_vazio(&(Lane){(v).lo, (v).hi})
+#define K_POPCOUNT(v) (__builtin_popcountll((v).lo) + __builtin_popcountll((v).hi))
+#define K_LIMPAR_TODOS(e, m)                         \
+    for (int k_ = 0; k_ < 9; k_++)                   \
+        (e)->cand[k_] = lane_andnot((e)->cand[k_], (m))
+#define K_ACUMULAR(e, um, dois)                                    \
+    do                                                             \
+    {                                                              \
+        (um) = K_ZERO();                                           \
+        (dois) = K_ZERO();                                         \
+        for (int k_ = 0; k_ < 9; k_++)                             \
+        {                                                          \
+            (dois) = lane_or((dois), lane_and((um), (e)->cand[k_])); \
+            (um) = lane_or((um), (e)->cand[k_]);                   \
+        }                                                          \
+    } while (0)
+
+#include "solver_bitboard_kernel.h"
+
+#undef K_SUFIXO
+#undef K_NOME_TEXTO
+#undef K_ATRIBUTO
+#undef K_V
+#undef K_CARREGAR
+#undef K_GUARDAR
+#undef K_AND
+#undef K_OR
+#undef K_ANDNOT
+#undef K_ZERO
+#undef K_E_ZERO
+#undef K_POPCOUNT
+#undef K_LIMPAR_TODOS
+#undef K_ACUMULAR
+
+#ifdef BITBOARD_X86
+
+// ---------------------------------------------------------------------------
+// Kernel SSE2: um registo __m128i por bitboard
+// ---------------------------------------------------------------------------
+
+__attribute__((target("sse2"))) static inline int sse2_e_zero(__m128i v)
+{
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) == 0xFFFF;
+}
+
+__attribute__((target("sse2"))) static inline int sse2_popcount(__m128i v)
+{
+    Lane l;
+    _mm_store_si128((__m128i *)&l, v);
+    return __builtin_popcountll(l.lo) + __builtin_popcountll(l.hi);
+}
+
+#define K_SUFIXO sse2
+#define K_NOME_TEXTO "SSE2"
+#define K_ATRIBUTO __attribute__((target("sse2")))
+#define K_V __m128i
+#define K_CARREGAR(p) _mm_load_si128((const __m128i *)(p))
+#define K_GUARDAR(p, v) _mm_store_si128((__m128i *)(p), (v))
+#define K_AND(a, b) _mm_and_si128((a), (b))
+#define K_OR(a, b) _mm_or_si128((a), (b))
+#define K_ANDNOT(a, b) _mm_andnot_si128((b), (a))
+#define K_ZERO() _mm_setzero_si128()
+#define K_E_ZERO(v) sse2_e_zero(v)
+#define K_POPCOUNT(v) sse2_popcount(v)
+#define K_LIMPAR_TODOS(e, m)                                                  \
+    for (int k_ = 0; k_ < 9; k_++)                                            \
+        _mm_store_si128((__m128i *)&(e)->cand[k_],                            \
+                        _mm_andnot_si128((m), _mm_load_si128((const __m128i *)&(e)->cand[k_])))
+#define K_ACUMULAR(e, um, dois)                                          \
+    do                                                                   \
+    {                                                                    \
+        (um) = _mm_setzero_si128();                                      \
+        (dois) = _mm_setzero_si128();                                    \
+        for (int k_ = 0; k_ < 9; k_++)                                   \
+        {                                                                \
+            __m128i c_ = _mm_load_si128((const __m128i *)&(e)->cand[k_]); \
+            (dois) = _mm_or_si128((dois), _mm_and_si128((um), c_));      \
+            (um) = _mm_or_si128((um), c_);                               \
+        }                                                                \
+    } while (0)
+
+#include "solver_bitboard_kernel.h"
+
+#undef K_SUFIXO
+#undef K_NOME_TEXTO
+#undef K_ATRIBUTO
+#undef K_LIMPAR_TODOS
+#undef K_ACUMULAR
+
+// ---------------------------------------------------------------------------
+// Kernel AVX2: as operações sobre os 9 dígitos tratam dois bitboards por
+// instrução (cand[0..7] em 4 registos __m256i + cand[8] em 128 bits)
+// ---------------------------------------------------------------------------
+
+__attribute__((target("avx2"))) static inline void avx2_limpar_todos(EstadoBitboard *e, __m128i m)
+{
+    __m256i m2 = _mm256_broadcastsi128_si256(m);
+    for (int k = 0; k < 8; k += 2)
+    {
+        __m256i *p = (__m256i *)&e->cand[k];
+        _mm256_store_si256(p, _mm256_andnot_si256(m2, _mm256_load_si256(p)));
+    }
+    _mm_store_si128((__m128i *)&e->cand[8], _mm_andnot_si128(m, _mm_load_si128((const __m128i *)&e->cand[8])));
+}
+
+__attribute__((target("avx2"))) static inline void avx2_acumular(const EstadoBitboard *e, __m128i *um, __m128i *dois)
+{
+    __m256i u = _mm256_setzero_si256();
+    __m256i d = _mm256_setzero_si256();
+    for (int k = 0; k < 8; k += 2)
+    {
+        __m256i c = _mm256_load_si256((const __m256i *)&e->cand[k]);
+        d = _mm256_or_si256(d, _mm256_and_si256(u, c));
+        u = _mm256_or_si256(u, c);
+    }
+
+    // Juntar as duas metades (dígitos pares e ímpares) e o nono dígito
+    __m128i u_lo = _mm256_castsi256_si128(u), u_hi = _mm256_extracti128_si256(u, 1);
+    __m128i d_lo = _mm256_castsi256_si128(d), d_hi = _mm256_extracti128_si256(d, 1);
+    __m128i uu = _mm_or_si128(u_lo, u_hi);
+    __m128i dd = _mm_or_si128(_mm_or_si128(d_lo, d_hi), _mm_and_si128(u_lo, u_hi));
+
+    __m128i c8 = _mm_load_si128((const __m128i *)&e->cand[8]);
+    *dois = _mm_or_si128(dd, _mm_and_si128(uu, c8));
+    *um = _mm_or_si128(uu, c8);
+}
+
+__attribute__((target("avx2"))) static inline int avx2_e_zero(__m128i v)
+{
+    return _mm_testz_si128(v, v);
+}
+
+__attribute__((target("avx2,popcnt"))) static inline int avx2_popcount(__m128i v)
+{
+    return (int)(_mm_popcnt_u64((uint64_t)_mm_cvtsi128_si64(v)) +
+                 _mm_popcnt_u64((uint64_t)_mm_extract_epi64(v, 1)));
+}
+
+#define K_SUFIXO avx2
+#define K_NOME_TEXTO "AVX2"
+#define K_ATRIBUTO __attribute__((target("avx2,popcnt")))
+#undef K_E_ZERO
+#undef K_POPCOUNT
+#define K_E_ZERO(v) avx2_e_zero(v)
+#define K_POPCOUNT(v) avx2_popcount(v)
+#define K_LIMPAR_TODOS(e, m) avx2_limpar_todos((e), (m))
+#define K_ACUMULAR(e, um, dois) avx2_acumular((e), &(um), &(dois))
+
+#include "solver_bitboard_kernel.h"
+
+#undef K_SUFIXO
+#undef K_NOME_TEXTO
+#undef K_ATRIBUTO
+#undef K_V
+#undef K_CARREGAR
+#undef K_GUARDAR
+#undef K_AND
+#undef K_OR
+#undef K_ANDNOT
+#undef K_ZERO
+#undef K_E_ZERO
+#undef K_POPCOUNT
+#undef K_LIMPAR_TODOS
+#undef K_ACUMULAR
+
+#endif // BITBOARD_X86
+
+// ---------------------------------------------------------------------------
+// Inicialização e escolha do kernel
+// ---------------------------------------------------------------------------
+
+static const KernelBitboard *kernel_ativo = &kernel_escalar;
+static pthread_once_t bitboard_once = PTHREAD_ONCE_INIT;
+
+static void inicializar_bitboard(void)
+{
+    memset(bb_celula, 0, sizeof(bb_celula));
+    memset(bb_pares, 0, sizeof(bb_pares));
+    memset(bb_unidades, 0, sizeof(bb_unidades));
+    memset(&bb_todas, 0, sizeof(bb_todas));
+
+    for (int celula = 0; celula < 81; celula++)
+    {
+        int r = celula / 9, c = celula % 9, b = (r / 3) * 3 + c / 3;
+
+        lane_ligar(&bb_celula[celula], celula);
+        lane_ligar(&bb_unidades[r], celula);
+        lane_ligar(&bb_unidades[9 + c], celula);
+        lane_ligar(&bb_unidades[18 + b], celula);
+        lane_ligar(&bb_todas, celula);
+    }
+
+    for (int celula = 0; celula < 81; celula++)
+    {
+        int r = celula / 9, c = celula % 9, b = (r / 3) * 3 + c / 3;
+        bb_pares[celula] = lane_or(lane_or(bb_unidades[r], bb_unidades[9 + c]), bb_unidades[18 + b]);
+    }
+
+#ifdef BITBOARD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+        kernel_ativo = &kernel_avx2;
+    else if (__builtin_cpu_supports("sse2"))
+        kernel_ativo = &kernel_sse2;
+#endif
+}
+
+const char *bitboard_kernel_ativo(void)
+{
+    pthread_once(&bitboard_once, inicializar_bitboard);
+    return kernel_ativo->nome;
+}
+
+int resolver_sudoku_bitboard(Tabuleiro *tabuleiro)
+{
+    return resolver_sudoku_bitboard_cancelavel(tabuleiro, NULL);
+}
+
+int resolver_sudoku_bitboard_cancelavel(Tabuleiro *tabuleiro, const atomic_int *parar)
+{
+    pthread_once(&bitboard_once, inicializar_bitboard);
+
+    EstadoBitboard estado;
+    memset(&estado, 0, sizeof(estado));
+    for (int d = 0; d < 9; d++)
+        estado.cand[d] = bb_todas;
+    estado.vazias = bb_todas;
+
+    // Colocar as pistas (uma pista que já não é candidata está em conflito)
+    for (int celula = 0; celula < 81; celula++)
+    {
+        int num = tabuleiro->celulas[celula];
+        if (num == 0)
+            continue;
+        if (num < 1 || num > 9 || !lane_testar(&estado.cand[num - 1], celula))
+            return 0;
+
+        kernel_ativo->colocar(&estado, celula, num - 1);
+    }
+
+    if (!kernel_ativo->pesquisar(&estado, parar))
+        return 0;
+
+    for (int d = 0; d < 9; d++)
+    {
+        Lane l = estado.colocados[d];
+        while (!lane_vazio(&l))
+        {
+            int celula = lane_extrair(&l);
+            tabuleiro->celulas[celula] = (uint8_t)(d + 1);
+        }
+    }
+
+    return 1;
+}
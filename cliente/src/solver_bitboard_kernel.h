@@ -0,0 +1,179 @@
+// cliente/src/solver_bitboard_kernel.h - Núcleo do solver por bitboards (modelo)
+//
+// Este ficheiro NÃO é um header normal: é incluído várias vezes por
+// solver_bitboard.c, uma por conjunto de instruções, com as macros abaixo
+// definidas antes de cada inclusão. Assim o mesmo algoritmo é compilado
+// em versão escalar, SSE2 e AVX2 e o melhor é escolhido em runtime.
+//
+// Macros esperadas:
+//   K_SUFIXO            sufixo dos nomes gerados (escalar, sse2, avx2)
+//   K_NOME_TEXTO        nome do kernel para logs ("escalar", "SSE2", "AVX2")
+//   K_ATRIBUTO          atributo de função (ex: __attribute__((target("avx2"))))
+//   K_V                 tipo de um registo de 128 bits
+//   K_CARREGAR(p)       lê um Lane para K_V
+//   K_GUARDAR(p, v)     escreve um K_V num Lane
+//   K_AND / K_OR        operações bit a bit
+//   K_ANDNOT(a, b)      a & ~b
+//   K_ZERO()            registo a zeros
+//   K_E_ZERO(v)         1 se o registo é todo zero
+//   K_POPCOUNT(v)       número de bits ligados
+//   K_LIMPAR_TODOS(e, m)         cand[d] &= ~m para os 9 dígitos
+//   K_ACUMULAR(e, um, dois)      células com >=1 e >=2 candidatos
+
+#define K_CONCAT2(a, b) a##_##b
+#define K_CONCAT(a, b) K_CONCAT2(a, b)
+#define K_NOME(nome) K_CONCAT(nome, K_SUFIXO)
+
+// Coloca o dígito d (0-8) na célula e elimina-o dos pares
+static K_ATRIBUTO inline void K_NOME(colocar)(EstadoBitboard *e, int celula, int d)
+{
+    K_V bit = K_CARREGAR(&bb_celula[celula]);
+
+    K_LIMPAR_TODOS(e, bit);
+    K_GUARDAR(&e->cand[d], K_ANDNOT(K_CARREGAR(&e->cand[d]), K_CARREGAR(&bb_pares[celula])));
+    K_GUARDAR(&e->colocados[d], K_OR(K_CARREGAR(&e->colocados[d]), bit));
+    K_GUARDAR(&e->vazias, K_ANDNOT(K_CARREGAR(&e->vazias), bit));
+}
+
+// Naked + hidden singles até ao ponto fixo. Devolve 0 em contradição.
+static K_ATRIBUTO int K_NOME(propagar)(EstadoBitboard *e)
+{
+    for (;;)
+    {
+        K_V um, dois;
+        K_ACUMULAR(e, um, dois);
+
+        K_V vazias = K_CARREGAR(&e->vazias);
+
+        // Célula vazia sem nenhum candidato
+        if (!K_E_ZERO(K_ANDNOT(vazias, um)))
+            return 0;
+
+        // Naked singles: exatamente um candidato
+        Lane singles;
+        K_GUARDAR(&singles, K_AND(K_ANDNOT(um, dois), vazias));
+
+        if (singles.lo | singles.hi)
+        {
+            while (singles.lo | singles.hi)
+            {
+                int celula = lane_extrair(&singles);
+
+                // Uma colocação anterior desta ronda pode ter esvaziado a célula
+                int d = 0;
+                while (d < 9 && !lane_testar(&e->cand[d], celula))
+                    d++;
+                if (d == 9)
+                    return 0;
+
+                K_NOME(colocar)(e, celula, d);
+            }
+            continue;
+        }
+
+        // Hidden singles: dígito com um único lugar numa unidade
+        int progresso = 0;
+        for (int d = 0; d < 9; d++)
+        {
+            for (int u = 0; u < 27; u++)
+            {
+                K_V unidade = K_CARREGAR(&bb_unidades[u]);
+                if (!K_E_ZERO(K_AND(K_CARREGAR(&e->colocados[d]), unidade)))
+                    continue;
+
+                K_V lugares = K_AND(K_CARREGAR(&e->cand[d]), unidade);
+                int n = K_POPCOUNT(lugares);
+                if (n == 0)
+                    return 0;
+                if (n == 1)
+                {
+                    Lane l;
+                    K_GUARDAR(&l, lugares);
+                    K_NOME(colocar)(e, lane_extrair(&l), d);
+                    progresso = 1;
+                }
+            }
+        }
+
+        if (!progresso)
+            return 1;
+    }
+}
+
+// Pesquisa em profundidade com cópia do estado em cada ramo.
+// parar (opcional): abandona a pesquisa quando fica != 0
+static K_ATRIBUTO int K_NOME(pesquisar)(EstadoBitboard *e, const atomic_int *parar)
+{
+    if (parar && atomic_load_explicit(parar, memory_order_relaxed))
+        return 0;
+
+    if (!K_NOME(propagar)(e))
+        return 0;
+
+    if (lane_vazio(&e->vazias))
+        return 1;
+
+    // Preferir uma célula com exatamente 2 candidatos (contagem bit-sliced);
+    // senão, a célula com menos candidatos
+    K_V um = K_ZERO(), dois = K_ZERO(), tres = K_ZERO();
+    for (int d = 0; d < 9; d++)
+    {
+        K_V c = K_CARREGAR(&e->cand[d]);
+        tres = K_OR(tres, K_AND(dois, c));
+        dois = K_OR(dois, K_AND(um, c));
+        um = K_OR(um, c);
+    }
+
+    Lane pares;
+    K_GUARDAR(&pares, K_ANDNOT(dois, tres));
+
+    int celula = -1;
+    if (pares.lo | pares.hi)
+    {
+        celula = lane_extrair(&pares);
+    }
+    else
+    {
+        int melhor = 10;
+        Lane vazias = e->vazias;
+        while ((vazias.lo | vazias.hi) && melhor > 3)
+        {
+            int c = lane_extrair(&vazias);
+            int n = 0;
+            for (int d = 0; d < 9; d++)
+                n += lane_testar(&e->cand[d], c);
+            if (n < melhor)
+            {
+                melhor = n;
+                celula = c;
+            }
+        }
+    }
+
+    for (int d = 0; d < 9; d++)
+    {
+        if (!lane_testar(&e->cand[d], celula))
+            continue;
+
+        EstadoBitboard filho = *e;
+        K_NOME(colocar)(&filho, celula, d);
+
+        if (K_NOME(pesquisar)(&filho, parar))
+        {
+            *e = filho;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static const KernelBitboard K_NOME(kernel) = {
+    .nome = K_NOME_TEXTO,
+    .colocar = K_NOME(colocar),
+    .pesquisar = K_NOME(pesquisar),
+};
+
+#undef K_CONCAT2
+#undef K_CONCAT
+#undef K_NOME
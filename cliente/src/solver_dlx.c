@@ -0,0 +1,274 @@
+// cliente/src/solver_dlx.c - Solver de Sudoku por cobertura exata (Dancing Links / Algoritmo X)
+//
+// O Sudoku 9x9 é um problema de cobertura exata com 324 colunas:
+//   [  0,  81) célula (r,c) preenchida
+//   [ 81, 162) linha r contém o dígito d
+//   [162, 243) coluna c contém o dígito d
+//   [243, 324) bloco b contém o dígito d
+// e 729 linhas (uma por par célula/dígito), cada uma com 4 nós.
+//
+// A matriz é construída uma única vez como modelo só de leitura. Cada
+// thread resolve na sua própria cópia (criada no primeiro uso e libertada
+// quando a thread termina), pelo que várias resoluções correm em paralelo.
+// As pistas são "cobertas" antes da pesquisa e descobertas pela ordem
+// inversa no fim, o que devolve a cópia exatamente ao estado do modelo e
+// permite reutilizá-la entre jogos.
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "solver_dlx.h"
+
+#define DLX_COLUNAS 324
+#define DLX_LINHAS 729
+#define DLX_RAIZ 0
+#define DLX_NOS (1 + DLX_COLUNAS + DLX_LINHAS * 4)
+
+// Nós guardados em arrays paralelos (índices em vez de ponteiros): a
+// matriz inteira ocupa cerca de 79 KB contíguos, copiados de uma vez.
+typedef struct
+{
+    int esq[DLX_NOS];
+    int dir[DLX_NOS];
+    int cima[DLX_NOS];
+    int baixo[DLX_NOS];
+    int coluna[DLX_NOS]; // Cabeçalho de coluna de cada nó
+    int linha[DLX_NOS];  // Linha da matriz (célula*9 + dígito-1) de cada nó
+    int tamanho[1 + DLX_COLUNAS];
+} MatrizDLX;
+
+static MatrizDLX modelo; // Só de leitura depois de construído
+static pthread_once_t matriz_once = PTHREAD_ONCE_INIT;
+static pthread_key_t chave_matriz; // Cópia de trabalho de cada thread
+
+// Primeiro nó da linha (célula, dígito) - as 4 entradas são consecutivas
+static inline int primeiro_no(int celula, int num)
+{
+    return 1 + DLX_COLUNAS + (celula * 9 + (num - 1)) * 4;
+}
+
+static void construir_matriz(void)
+{
+    MatrizDLX *x = &modelo;
+
+    pthread_key_create(&chave_matriz, free);
+
+    // Cabeçalhos: lista circular horizontal a partir da raiz
+    for (int c = 0; c <= DLX_COLUNAS; c++)
+    {
+        x->esq[c] = (c == 0) ? DLX_COLUNAS : c - 1;
+        x->dir[c] = (c == DLX_COLUNAS) ? 0 : c + 1;
+        x->cima[c] = c;
+        x->baixo[c] = c;
+        x->coluna[c] = c;
+        x->linha[c] = -1;
+        x->tamanho[c] = 0;
+    }
+
+    for (int celula = 0; celula < 81; celula++)
+    {
+        int r = celula / 9, c = celula % 9, b = (r / 3) * 3 + c / 3;
+
+        for (int num = 1; num <= 9; num++)
+        {
+            int d = num - 1;
+            int colunas[4] = {
+                1 + celula,
+                1 + 81 + r * 9 + d,
+                1 + 162 + c * 9 + d,
+                1 + 243 + b * 9 + d};
+            int base = primeiro_no(celula, num);
+
+            for (int k = 0; k < 4; k++)
+            {
+                int no = base + k;
+                int col = colunas[k];
+
+                // Ligação horizontal circular entre os 4 nós da linha
+                x->esq[no] = base + (k + 3) % 4;
+                x->dir[no] = base + (k + 1) % 4;
+
+                // Inserir no fundo da coluna
+                x->coluna[no] = col;
+                x->linha[no] = celula * 9 + d;
+                x->cima[no] = x->cima[col];
+                x->baixo[no] = col;
+                x->baixo[x->cima[col]] = no;
+                x->cima[col] = no;
+                x->tamanho[col]++;
+            }
+        }
+    }
+}
+
+static void cobrir(MatrizDLX *x, int col)
+{
+    x->dir[x->esq[col]] = x->dir[col];
+    x->esq[x->dir[col]] = x->esq[col];
+
+    for (int i = x->baixo[col]; i != col; i = x->baixo[i])
+    {
+        for (int j = x->dir[i]; j != i; j = x->dir[j])
+        {
+            x->baixo[x->cima[j]] = x->baixo[j];
+            x->cima[x->baixo[j]] = x->cima[j];
+            x->tamanho[x->coluna[j]]--;
+        }
+    }
+}
+
+static void descobrir(MatrizDLX *x, int col)
+{
+    for (int i = x->cima[col]; i != col; i = x->cima[i])
+    {
+        for (int j = x->esq[i]; j != i; j = x->esq[j])
+        {
+            x->tamanho[x->coluna[j]]++;
+            x->baixo[x->cima[j]] = j;
+            x->cima[x->baixo[j]] = j;
+        }
+    }
+
+    x->dir[x->esq[col]] = col;
+    x->esq[x->dir[col]] = col;
+}
+
+// Algoritmo X: escolhe sempre a coluna com menos linhas (heurística S)
+static int pesquisar(MatrizDLX *x, int *escolhidas, int profundidade, const atomic_int *parar)
+{
+    if (x->dir[DLX_RAIZ] == DLX_RAIZ)
+        return 1;
+
+    // Cancelado: recuar sem explorar (os descobrir() dos níveis acima repõem a matriz)
+    if (parar && atomic_load_explicit(parar, memory_order_relaxed))
+        return 0;
+
+    int col = x->dir[DLX_RAIZ];
+    int menor = x->tamanho[col];
+    for (int c = x->dir[col]; c != DLX_RAIZ && menor > 1; c = x->dir[c])
+    {
+        if (x->tamanho[c] < menor)
+        {
+            menor = x->tamanho[c];
+            col = c;
+        }
+    }
+
+    if (menor == 0)
+        return 0;
+
+    cobrir(x, col);
+
+    for (int i = x->baixo[col]; i != col; i = x->baixo[i])
+    {
+        escolhidas[profundidade] = x->linha[i];
+
+        for (int j = x->dir[i]; j != i; j = x->dir[j])
+            cobrir(x, x->coluna[j]);
+
+        int resolvido = pesquisar(x, escolhidas, profundidade + 1, parar);
+
+        for (int j = x->esq[i]; j != i; j = x->esq[j])
+            descobrir(x, x->coluna[j]);
+
+        if (resolvido)
+        {
+            descobrir(x, col);
+            return 1;
+        }
+    }
+
+    descobrir(x, col);
+    return 0;
+}
+
+// Cópia de trabalho da thread atual (NULL se faltar memória)
+static MatrizDLX *matriz_da_thread(void)
+{
+    pthread_once(&matriz_once, construir_matriz);
+
+    MatrizDLX *x = pthread_getspecific(chave_matriz);
+    if (!x)
+    {
+        x = malloc(sizeof(MatrizDLX));
+        if (!x)
+            return NULL;
+        memcpy(x, &modelo, sizeof(MatrizDLX));
+        pthread_setspecific(chave_matriz, x);
+    }
+    return x;
+}
+
+int resolver_sudoku_dlx(Tabuleiro *tabuleiro)
+{
+    return resolver_sudoku_dlx_cancelavel(tabuleiro, NULL);
+}
+
+int resolver_sudoku_dlx_cancelavel(Tabuleiro *tabuleiro, const atomic_int *parar)
+{
+    MatrizDLX *x = matriz_da_thread();
+    if (!x)
+        return 0;
+
+    int pistas[81];   // Primeiro nó da linha de cada pista coberta
+    int n_pistas = 0;
+    int escolhidas[81];
+    int consistente = 1;
+    char coberta[1 + DLX_COLUNAS];
+    memset(coberta, 0, sizeof(coberta));
+
+    // 1. Cobrir as colunas satisfeitas pelas pistas
+    for (int celula = 0; celula < 81 && consistente; celula++)
+    {
+        int num = tabuleiro->celulas[celula];
+        if (num == 0)
+            continue;
+        if (num < 1 || num > 9)
+        {
+            consistente = 0;
+            break;
+        }
+
+        int base = primeiro_no(celula, num);
+
+        // Pistas em conflito tentariam cobrir a mesma coluna duas vezes
+        for (int k = 0; k < 4; k++)
+        {
+            if (coberta[x->coluna[base + k]])
+                consistente = 0;
+        }
+        if (!consistente)
+            break;
+
+        for (int k = 0; k < 4; k++)
+        {
+            coberta[x->coluna[base + k]] = 1;
+            cobrir(x, x->coluna[base + k]);
+        }
+        pistas[n_pistas++] = base;
+    }
+
+    // 2. Pesquisar as restantes células
+    int resolvido = 0;
+    if (consistente)
+    {
+        resolvido = pesquisar(x, escolhidas, 0, parar);
+
+        if (resolvido)
+        {
+            for (int k = 0; k < 81 - n_pistas; k++)
+            {
+                int celula = escolhidas[k] / 9;
+                tabuleiro->celulas[celula] = (uint8_t)(escolhidas[k] % 9 + 1);
+            }
+        }
+    }
+
+    // 3. Descobrir as pistas pela ordem inversa (a cópia volta ao estado do modelo)
+    for (int p = n_pistas - 1; p >= 0; p--)
+    {
+        for (int k = 3; k >= 0; k--)
+            descobrir(x, x->coluna[pistas[p] + k]);
+    }
+
+    return resolvido;
+}
@@ -0,0 +1,831 @@
+// cliente/src/solver_sat.c - Solver de Sudoku por SAT (CDCL)
+//
+// Codificação direta: uma variável por par (célula, dígito), var =
+// célula * lado + dígito - 1. As pistas são aplicadas antes de gerar as
+// cláusulas: as variáveis que elas já decidem ficam fixas no nível 0 e só
+// se codificam os candidatos que restam, com
+//   - cada célula vazia tem pelo menos um e no máximo um dos candidatos
+//   - cada dígito em falta numa linha/coluna/bloco aparece pelo menos uma
+//     e no máximo uma vez entre as células onde ainda cabe
+// (o "no máximo um" é a codificação par a par, em cláusulas binárias).
+//
+// O solver é um CDCL clássico:
+//   - dois literais vigiados por cláusula (lits[0] e lits[1])
+//   - análise de conflitos até ao primeiro UIP, com minimização local da
+//     cláusula aprendida e retrocesso não cronológico
+//   - VSIDS (atividades com decaimento num heap) e memória de fase
+//   - reinícios pela sequência de Luby e limpeza periódica das cláusulas
+//     aprendidas com pior LBD
+// Todo o estado pertence a uma resolução, por isso várias podem correr em
+// paralelo (portfolio).
+#include <stdlib.h>
+#include <string.h>
+#include "solver_sat.h"
+#include "tabuleiro_nxn.h"
+
+#define SAT_FALSO 0
+#define SAT_VERDADEIRO 1
+#define SAT_INDEFINIDO 2
+
+#define SAT_SEM_RAZAO -1
+
+// Cabeçalho de uma cláusula no arena: [tamanho, marcas, lits...]
+#define CL_TAMANHO(s, c) ((s)->arena[(c)])
+#define CL_MARCAS(s, c) ((s)->arena[(c) + 1])
+#define CL_LITS(s, c) (&(s)->arena[(c) + 2])
+#define MARCA_APRENDIDA 1
+#define MARCA_APAGADA 2
+#define CL_LBD(s, c) (CL_MARCAS(s, c) >> 2)
+
+#define REINICIO_CONFLITOS 100 // Unidade da sequência de Luby
+#define DECAIMENTO_VSIDS 0.95
+#define APRENDIDAS_INICIAL 2000 // Limite de aprendidas antes da 1ª limpeza
+
+// Literais: 2*var para var verdadeira, 2*var+1 para a negação
+static inline int lit_var(int lit) { return lit >> 1; }
+static inline int lit_pos(int var) { return var << 1; }
+static inline int lit_neg(int var) { return (var << 1) | 1; }
+
+typedef struct
+{
+    int *v;
+    int n;
+    int cap;
+} VetorInt;
+
+typedef struct
+{
+    int num_vars;
+
+    int *arena; // Todas as cláusulas, referidas pelo deslocamento no arena
+    int arena_tam;
+    int arena_cap;
+    VetorInt originais;
+    VetorInt aprendidas;
+    VetorInt *vigias; // vigias[lit]: cláusulas com lit num dos dois primeiros lugares
+
+    uint8_t *valor; // Por variável
+    int *nivel;
+    int *razao; // Cláusula que implicou a variável (SAT_SEM_RAZAO nas decisões)
+    int *trilho;
+    int n_trilho;
+    int cabeca;       // Próximo literal do trilho a propagar
+    int *inicio_nivel; // Posição do trilho onde começa cada nível
+    int nivel_atual;
+
+    double *atividade;
+    double inc_atividade;
+    uint8_t *fase; // Último valor de cada variável (memória de fase)
+    int *heap;     // Variáveis ordenadas por atividade (máximo na raiz)
+    int *pos_heap; // -1 = fora do heap
+    int n_heap;
+
+    uint8_t *visto; // Auxiliar da análise de conflitos
+    int *aprendida; // Cláusula em construção
+    int *marca_nivel;
+    int carimbo;
+
+    const atomic_int *parar;
+    EstatisticasSat est;
+} Sat;
+
+// ---------------------------------------------------------------------------
+// Vetores e arena
+
+static int vetor_juntar(VetorInt *vet, int x)
+{
+    if (vet->n == vet->cap)
+    {
+        int cap = vet->cap ? vet->cap * 2 : 4;
+        int *novo = realloc(vet->v, (size_t)cap * sizeof(int));
+        if (!novo)
+            return 0;
+        vet->v = novo;
+        vet->cap = cap;
+    }
+    vet->v[vet->n++] = x;
+    return 1;
+}
+
+static inline int valor_lit(const Sat *s, int lit)
+{
+    uint8_t v = s->valor[lit_var(lit)];
+    return v == SAT_INDEFINIDO ? SAT_INDEFINIDO : v ^ (lit & 1);
+}
+
+// Copia a cláusula para o arena e vigia os dois primeiros literais.
+// Devolve a referência ou -1 sem memória.
+static int guardar_clausula(Sat *s, const int *lits, int tam, int marcas)
+{
+    if (s->arena_tam + tam + 2 > s->arena_cap)
+    {
+        int cap = s->arena_cap * 2;
+        while (cap < s->arena_tam + tam + 2)
+            cap *= 2;
+        int *novo = realloc(s->arena, (size_t)cap * sizeof(int));
+        if (!novo)
+            return -1;
+        s->arena = novo;
+        s->arena_cap = cap;
+    }
+
+    int c = s->arena_tam;
+    CL_TAMANHO(s, c) = tam;
+    CL_MARCAS(s, c) = marcas;
+    memcpy(CL_LITS(s, c), lits, (size_t)tam * sizeof(int));
+    s->arena_tam += tam + 2;
+
+    if (!vetor_juntar(&s->vigias[lits[0]], c) || !vetor_juntar(&s->vigias[lits[1]], c))
+        return -1;
+    return c;
+}
+
+// ---------------------------------------------------------------------------
+// Heap de atividades (VSIDS)
+
+static void heap_subir(Sat *s, int i)
+{
+    int var = s->heap[i];
+    while (i > 0)
+    {
+        int pai = (i - 1) / 2;
+        if (s->atividade[s->heap[pai]] >= s->atividade[var])
+            break;
+        s->heap[i] = s->heap[pai];
+        s->pos_heap[s->heap[i]] = i;
+        i = pai;
+    }
+    s->heap[i] = var;
+    s->pos_heap[var] = i;
+}
+
+static void heap_descer(Sat *s, int i)
+{
+    int var = s->heap[i];
+    for (;;)
+    {
+        int filho = 2 * i + 1;
+        if (filho >= s->n_heap)
+            break;
+        if (filho + 1 < s->n_heap && s->atividade[s->heap[filho + 1]] > s->atividade[s->heap[filho]])
+            filho++;
+        if (s->atividade[s->heap[filho]] <= s->atividade[var])
+            break;
+        s->heap[i] = s->heap[filho];
+        s->pos_heap[s->heap[i]] = i;
+        i = filho;
+    }
+    s->heap[i] = var;
+    s->pos_heap[var] = i;
+}
+
+static void heap_inserir(Sat *s, int var)
+{
+    if (s->pos_heap[var] >= 0)
+        return;
+    s->heap[s->n_heap] = var;
+    s->pos_heap[var] = s->n_heap++;
+    heap_subir(s, s->pos_heap[var]);
+}
+
+static int heap_retirar(Sat *s)
+{
+    int var = s->heap[0];
+    s->pos_heap[var] = -1;
+    if (--s->n_heap > 0)
+    {
+        s->heap[0] = s->heap[s->n_heap];
+        s->pos_heap[s->heap[0]] = 0;
+        heap_descer(s, 0);
+    }
+    return var;
+}
+
+static void reforcar_variavel(Sat *s, int var)
+{
+    if ((s->atividade[var] += s->inc_atividade) > 1e100)
+    {
+        // Reescalar para não transbordar (a ordem mantém-se)
+        for (int v = 0; v < s->num_vars; v++)
+            s->atividade[v] *= 1e-100;
+        s->inc_atividade *= 1e-100;
+    }
+    if (s->pos_heap[var] >= 0)
+        heap_subir(s, s->pos_heap[var]);
+}
+
+// ---------------------------------------------------------------------------
+// Atribuições, propagação e retrocesso
+
+static inline void atribuir(Sat *s, int lit, int razao)
+{
+    int var = lit_var(lit);
+    s->valor[var] = (uint8_t)!(lit & 1);
+    s->nivel[var] = s->nivel_atual;
+    s->razao[var] = razao;
+    s->trilho[s->n_trilho++] = lit;
+}
+
+// Propaga o trilho a partir da cabeça. Devolve a cláusula em conflito ou
+// -1 se não houver conflito.
+static int propagar(Sat *s)
+{
+    while (s->cabeca < s->n_trilho)
+    {
+        int falso = s->trilho[s->cabeca++] ^ 1;
+        VetorInt *vig = &s->vigias[falso];
+        int i = 0, j = 0;
+
+        s->est.propagacoes++;
+        while (i < vig->n)
+        {
+            int c = vig->v[i++];
+            int *lits = CL_LITS(s, c);
+            int tam = CL_TAMANHO(s, c);
+
+            // O literal que ficou falso passa para lits[1]
+            if (lits[0] == falso)
+            {
+                lits[0] = lits[1];
+                lits[1] = falso;
+            }
+            if (valor_lit(s, lits[0]) == SAT_VERDADEIRO)
+            {
+                vig->v[j++] = c;
+                continue;
+            }
+
+            // Procurar outro literal não falso para vigiar
+            int k;
+            for (k = 2; k < tam; k++)
+            {
+                if (valor_lit(s, lits[k]) != SAT_FALSO)
+                {
+                    lits[1] = lits[k];
+                    lits[k] = falso;
+                    vetor_juntar(&s->vigias[lits[1]], c);
+                    break;
+                }
+            }
+            if (k < tam)
+                continue;
+
+            // Unitária ou em conflito: continua a vigiar 'falso'
+            vig->v[j++] = c;
+            if (valor_lit(s, lits[0]) == SAT_FALSO)
+            {
+                while (i < vig->n)
+                    vig->v[j++] = vig->v[i++];
+                vig->n = j;
+                return c;
+            }
+            atribuir(s, lits[0], c);
+        }
+        vig->n = j;
+    }
+    return -1;
+}
+
+static void retroceder(Sat *s, int nivel)
+{
+    if (s->nivel_atual <= nivel)
+        return;
+
+    int limite = s->inicio_nivel[nivel + 1];
+    for (int i = s->n_trilho - 1; i >= limite; i--)
+    {
+        int var = lit_var(s->trilho[i]);
+        s->fase[var] = s->valor[var];
+        s->valor[var] = SAT_INDEFINIDO;
+        heap_inserir(s, var);
+    }
+    s->n_trilho = limite;
+    s->cabeca = limite;
+    s->nivel_atual = nivel;
+}
+
+// ---------------------------------------------------------------------------
+// Análise de conflitos (primeiro UIP)
+
+// Um literal da cláusula aprendida é redundante se a sua razão só tiver
+// literais que já lá estão (ou do nível 0)
+static int redundante(Sat *s, int lit)
+{
+    int c = s->razao[lit_var(lit)];
+    if (c == SAT_SEM_RAZAO)
+        return 0;
+
+    int *lits = CL_LITS(s, c);
+    for (int k = 1; k < CL_TAMANHO(s, c); k++)
+    {
+        int var = lit_var(lits[k]);
+        if (!s->visto[var] && s->nivel[var] > 0)
+            return 0;
+    }
+    return 1;
+}
+
+// Constrói em s->aprendida a cláusula aprendida do conflito (o literal a
+// afirmar em [0], o de nível mais alto a seguir em [1]). Devolve o
+// tamanho; *nivel_retorno recebe o nível para onde retroceder e *lbd o
+// número de níveis distintos.
+static int analisar(Sat *s, int conflito, int *nivel_retorno, int *lbd)
+{
+    int caminho = 0, lit = -1, n = 1;
+    int idx = s->n_trilho - 1;
+    int c = conflito;
+
+    do
+    {
+        int *lits = CL_LITS(s, c);
+        for (int k = (lit == -1) ? 0 : 1; k < CL_TAMANHO(s, c); k++)
+        {
+            int q = lits[k];
+            int var = lit_var(q);
+            if (s->visto[var] || s->nivel[var] == 0)
+                continue;
+
+            s->visto[var] = 1;
+            reforcar_variavel(s, var);
+            if (s->nivel[var] >= s->nivel_atual)
+                caminho++;
+            else
+                s->aprendida[n++] = q;
+        }
+
+        while (!s->visto[lit_var(s->trilho[idx])])
+            idx--;
+        lit = s->trilho[idx--];
+        c = s->razao[lit_var(lit)];
+        s->visto[lit_var(lit)] = 0;
+        caminho--;
+    } while (caminho > 0);
+    s->aprendida[0] = lit ^ 1;
+
+    // Minimização local: os redundantes passam para o fim (aprendida[m..n))
+    // para se poder limpar o 'visto' de todos depois
+    int m = 1;
+    for (int k = 1; k < n; k++)
+    {
+        if (!redundante(s, s->aprendida[k]))
+        {
+            int tmp = s->aprendida[m];
+            s->aprendida[m++] = s->aprendida[k];
+            s->aprendida[k] = tmp;
+        }
+    }
+    for (int k = 1; k < n; k++)
+        s->visto[lit_var(s->aprendida[k])] = 0;
+    n = m;
+
+    // Nível de retorno: o mais alto depois do atual, colocado em [1]
+    *nivel_retorno = 0;
+    if (n > 1)
+    {
+        int max = 1;
+        for (int k = 2; k < n; k++)
+            if (s->nivel[lit_var(s->aprendida[k])] > s->nivel[lit_var(s->aprendida[max])])
+                max = k;
+        int tmp = s->aprendida[1];
+        s->aprendida[1] = s->aprendida[max];
+        s->aprendida[max] = tmp;
+        *nivel_retorno = s->nivel[lit_var(s->aprendida[1])];
+    }
+
+    s->carimbo++;
+    *lbd = 0;
+    for (int k = 0; k < n; k++)
+    {
+        int nv = s->nivel[lit_var(s->aprendida[k])];
+        if (s->marca_nivel[nv] != s->carimbo)
+        {
+            s->marca_nivel[nv] = s->carimbo;
+            (*lbd)++;
+        }
+    }
+    return n;
+}
+
+// ---------------------------------------------------------------------------
+// Limpeza das cláusulas aprendidas
+
+static int comparar_lbd_desc(const void *a, const void *b)
+{
+    return (*(const int *)b > *(const int *)a) - (*(const int *)b < *(const int *)a);
+}
+
+// Apaga metade das aprendidas com pior LBD (as de LBD <= 2 e as que são
+// razão de uma atribuição ficam) e compacta o arena. Chamada no nível 0.
+static int limpar_aprendidas(Sat *s)
+{
+    int n = s->aprendidas.n;
+    if (n == 0)
+        return 1;
+
+    // Limiar: LBD mediano
+    int *lbds = malloc((size_t)n * sizeof(int));
+    if (!lbds)
+        return 0;
+    for (int i = 0; i < n; i++)
+        lbds[i] = CL_LBD(s, s->aprendidas.v[i]);
+    qsort(lbds, (size_t)n, sizeof(int), comparar_lbd_desc);
+    int limiar = lbds[n / 2];
+    free(lbds);
+
+    int apagar = n / 2;
+    for (int i = 0; i < n && apagar > 0; i++)
+    {
+        int c = s->aprendidas.v[i];
+        int lbd = CL_LBD(s, c);
+        int var = lit_var(CL_LITS(s, c)[0]);
+        int presa = s->razao[var] == c && s->valor[var] != SAT_INDEFINIDO;
+        if (lbd > 2 && lbd >= limiar && !presa)
+        {
+            CL_MARCAS(s, c) |= MARCA_APAGADA;
+            apagar--;
+        }
+    }
+
+    // Compactar: as cláusulas vivas descem no arena, por ordem
+    int destino = 0;
+    s->originais.n = 0;
+    s->aprendidas.n = 0;
+    for (int c = 0; c < s->arena_tam;)
+    {
+        int tam = CL_TAMANHO(s, c);
+        int marcas = CL_MARCAS(s, c);
+        if (!(marcas & MARCA_APAGADA))
+        {
+            int var = lit_var(CL_LITS(s, c)[0]);
+            if (s->razao[var] == c)
+                s->razao[var] = destino;
+            memmove(&s->arena[destino], &s->arena[c], (size_t)(tam + 2) * sizeof(int));
+            vetor_juntar((marcas & MARCA_APRENDIDA) ? &s->aprendidas : &s->originais, destino);
+            destino += tam + 2;
+        }
+        c += tam + 2;
+    }
+    s->arena_tam = destino;
+
+    for (int lit = 0; lit < 2 * s->num_vars; lit++)
+        s->vigias[lit].n = 0;
+    for (int c = 0; c < s->arena_tam; c += CL_TAMANHO(s, c) + 2)
+    {
+        if (!vetor_juntar(&s->vigias[CL_LITS(s, c)[0]], c) ||
+            !vetor_juntar(&s->vigias[CL_LITS(s, c)[1]], c))
+            return 0;
+    }
+    return 1;
+}
+
+// ---------------------------------------------------------------------------
+// Pesquisa
+
+// Sequência de Luby: 1 1 2 1 1 2 4 1 1 2 1 1 2 4 8 ...
+static long luby(int x)
+{
+    int tamanho = 1, seq = 0;
+    while (tamanho < x + 1)
+    {
+        seq++;
+        tamanho = 2 * tamanho + 1;
+    }
+    while (tamanho - 1 != x)
+    {
+        tamanho = (tamanho - 1) >> 1;
+        seq--;
+        x = x % tamanho;
+    }
+    return 1L << seq;
+}
+
+static inline int cancelado(const Sat *s)
+{
+    return s->parar && atomic_load_explicit(s->parar, memory_order_relaxed);
+}
+
+// Devolve 1 (satisfazível), 0 (insatisfazível) ou -1 (cancelado/sem memória)
+static int pesquisar(Sat *s)
+{
+    long limite_aprendidas = APRENDIDAS_INICIAL + s->originais.n / 3;
+    int reinicio = 0;
+
+    if (propagar(s) >= 0)
+        return 0;
+
+    for (;;)
+    {
+        long limite_conflitos = luby(reinicio++) * REINICIO_CONFLITOS;
+        long conflitos_ronda = 0;
+
+        for (;;)
+        {
+            int conflito = propagar(s);
+            if (conflito >= 0)
+            {
+                s->est.conflitos++;
+                conflitos_ronda++;
+                if (s->nivel_atual == 0)
+                    return 0;
+                if (cancelado(s))
+                    return -1;
+
+                int nivel_retorno, lbd;
+                int n = analisar(s, conflito, &nivel_retorno, &lbd);
+                retroceder(s, nivel_retorno);
+
+                if (n == 1)
+                {
+                    atribuir(s, s->aprendida[0], SAT_SEM_RAZAO);
+                }
+                else
+                {
+                    int c = guardar_clausula(s, s->aprendida, n, MARCA_APRENDIDA | (lbd << 2));
+                    if (c < 0 || !vetor_juntar(&s->aprendidas, c))
+                        return -1;
+                    s->est.aprendidas++;
+                    atribuir(s, s->aprendida[0], c);
+                }
+                s->inc_atividade /= DECAIMENTO_VSIDS;
+                continue;
+            }
+
+            if (conflitos_ronda >= limite_conflitos)
+                break;
+
+            // Decisão: variável mais ativa ainda por atribuir
+            int var = -1;
+            while (s->n_heap > 0)
+            {
+                int v = heap_retirar(s);
+                if (s->valor[v] == SAT_INDEFINIDO)
+                {
+                    var = v;
+                    break;
+                }
+            }
+            if (var < 0)
+                return 1;
+
+            if ((++s->est.decisoes & 1023) == 0 && cancelado(s))
+                return -1;
+            s->inicio_nivel[++s->nivel_atual] = s->n_trilho;
+            atribuir(s, s->fase[var] ? lit_pos(var) : lit_neg(var), SAT_SEM_RAZAO);
+        }
+
+        s->est.reinicios++;
+        retroceder(s, 0);
+        if (s->aprendidas.n - s->n_trilho >= limite_aprendidas)
+        {
+            if (!limpar_aprendidas(s))
+                return -1;
+            limite_aprendidas += limite_aprendidas / 10;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Codificação do Sudoku
+
+// Acrescenta uma cláusula original, já simplificada pelas atribuições do
+// nível 0. Devolve 0 se ficar vazia (insatisfazível) ou sem memória.
+static int clausula_original(Sat *s, const int *lits, int tam)
+{
+    int tmp[NXN_MAX_LADO];
+    int n = 0;
+
+    for (int k = 0; k < tam; k++)
+    {
+        int v = valor_lit(s, lits[k]);
+        if (v == SAT_VERDADEIRO)
+            return 1;
+        if (v == SAT_INDEFINIDO)
+            tmp[n++] = lits[k];
+    }
+
+    if (n == 0)
+        return 0;
+    if (n == 1)
+    {
+        atribuir(s, tmp[0], SAT_SEM_RAZAO);
+        return 1;
+    }
+
+    int c = guardar_clausula(s, tmp, n, 0);
+    if (c < 0 || !vetor_juntar(&s->originais, c))
+        return 0;
+    s->est.clausulas++;
+    return 1;
+}
+
+// "Exatamente um" de lits: uma cláusula longa e as binárias par a par
+static int exatamente_um(Sat *s, const int *lits, int n)
+{
+    if (!clausula_original(s, lits, n))
+        return 0;
+
+    for (int a = 0; a < n; a++)
+    {
+        for (int b = a + 1; b < n; b++)
+        {
+            int par[2] = {lits[a] ^ 1, lits[b] ^ 1};
+            if (!clausula_original(s, par, 2))
+                return 0;
+        }
+    }
+    return 1;
+}
+
+static void libertar(Sat *s)
+{
+    if (s->vigias)
+        for (int lit = 0; lit < 2 * s->num_vars; lit++)
+            free(s->vigias[lit].v);
+    free(s->vigias);
+    free(s->arena);
+    free(s->originais.v);
+    free(s->aprendidas.v);
+    free(s->valor);
+    free(s->nivel);
+    free(s->razao);
+    free(s->trilho);
+    free(s->inicio_nivel);
+    free(s->atividade);
+    free(s->fase);
+    free(s->heap);
+    free(s->pos_heap);
+    free(s->visto);
+    free(s->aprendida);
+    free(s->marca_nivel);
+}
+
+static int alocar(Sat *s, int num_vars)
+{
+    memset(s, 0, sizeof(*s));
+    s->num_vars = num_vars;
+    s->arena_cap = 1 << 16;
+    s->inc_atividade = 1.0;
+
+    s->arena = malloc((size_t)s->arena_cap * sizeof(int));
+    s->vigias = calloc((size_t)(2 * num_vars), sizeof(VetorInt));
+    s->valor = malloc((size_t)num_vars);
+    s->nivel = malloc((size_t)num_vars * sizeof(int));
+    s->razao = malloc((size_t)num_vars * sizeof(int));
+    s->trilho = malloc((size_t)num_vars * sizeof(int));
+    s->inicio_nivel = malloc((size_t)(num_vars + 1) * sizeof(int));
+    s->atividade = calloc((size_t)num_vars, sizeof(double));
+    s->fase = malloc((size_t)num_vars);
+    s->heap = malloc((size_t)num_vars * sizeof(int));
+    s->pos_heap = malloc((size_t)num_vars * sizeof(int));
+    s->visto = calloc((size_t)num_vars, 1);
+    s->aprendida = malloc((size_t)num_vars * sizeof(int));
+    s->marca_nivel = calloc((size_t)(num_vars + 1), sizeof(int));
+
+    if (!s->arena || !s->vigias || !s->valor || !s->nivel || !s->razao || !s->trilho ||
+        !s->inicio_nivel || !s->atividade || !s->fase || !s->heap || !s->pos_heap ||
+        !s->visto || !s->aprendida || !s->marca_nivel)
+        return 0;
+
+    memset(s->valor, SAT_INDEFINIDO, (size_t)num_vars);
+    // Fase inicial verdadeira: decidir "a célula tem este dígito" propaga
+    // muito mais do que decidir que não tem
+    memset(s->fase, SAT_VERDADEIRO, (size_t)num_vars);
+    for (int v = 0; v < num_vars; v++)
+        s->pos_heap[v] = -1;
+    s->inicio_nivel[0] = 0;
+    return 1;
+}
+
+// k-ésima célula da unidade u: 0..lado-1 linhas, lado..2*lado-1 colunas,
+// o resto blocos
+static int celula_da_unidade(int bloco, int u, int k)
+{
+    int lado = bloco * bloco;
+    if (u < lado)
+        return u * lado + k;
+    if (u < 2 * lado)
+        return k * lado + (u - lado);
+    u -= 2 * lado;
+    return ((u / bloco) * bloco + k / bloco) * lado + (u % bloco) * bloco + k % bloco;
+}
+
+// Aplica as pistas (nível 0) e gera as cláusulas dos candidatos restantes.
+// Devolve 0 se o tabuleiro for contraditório.
+static int codificar(Sat *s, const uint8_t *celulas, int bloco)
+{
+    int lado = bloco * bloco;
+    int n = lado * lado;
+    uint32_t linhas[NXN_MAX_LADO] = {0}, colunas[NXN_MAX_LADO] = {0}, blocos[NXN_MAX_LADO] = {0};
+
+    for (int pos = 0; pos < n; pos++)
+    {
+        int d = celulas[pos];
+        if (d == 0)
+            continue;
+        int r = pos / lado, c = pos % lado, b = (r / bloco) * bloco + c / bloco;
+        uint32_t bit = 1u << (d - 1);
+        if (d > lado || ((linhas[r] | colunas[c] | blocos[b]) & bit))
+            return 0;
+        linhas[r] |= bit;
+        colunas[c] |= bit;
+        blocos[b] |= bit;
+    }
+
+    // Variáveis que as pistas já decidem
+    for (int pos = 0; pos < n; pos++)
+    {
+        int r = pos / lado, c = pos % lado, b = (r / bloco) * bloco + c / bloco;
+        uint32_t ocupados = linhas[r] | colunas[c] | blocos[b];
+        for (int d = 1; d <= lado; d++)
+        {
+            int var = pos * lado + d - 1;
+            if (celulas[pos])
+                atribuir(s, celulas[pos] == d ? lit_pos(var) : lit_neg(var), SAT_SEM_RAZAO);
+            else if (ocupados & (1u << (d - 1)))
+                atribuir(s, lit_neg(var), SAT_SEM_RAZAO);
+        }
+    }
+
+    int lits[NXN_MAX_LADO];
+    int m;
+
+    // Células: exatamente um dos candidatos
+    for (int pos = 0; pos < n; pos++)
+    {
+        if (celulas[pos])
+            continue;
+        m = 0;
+        for (int d = 1; d <= lado; d++)
+            if (s->valor[pos * lado + d - 1] != SAT_FALSO)
+                lits[m++] = lit_pos(pos * lado + d - 1);
+        if (!exatamente_um(s, lits, m))
+            return 0;
+    }
+
+    // Unidades: cada dígito exatamente uma vez (com o dígito já colocado,
+    // por uma pista ou por um single achado acima, a cláusula cai)
+    for (int u = 0; u < 3 * lado; u++)
+    {
+        for (int d = 1; d <= lado; d++)
+        {
+            m = 0;
+            for (int k = 0; k < lado; k++)
+            {
+                int var = celula_da_unidade(bloco, u, k) * lado + d - 1;
+                if (s->valor[var] != SAT_FALSO)
+                    lits[m++] = lit_pos(var);
+            }
+            if (!exatamente_um(s, lits, m))
+                return 0;
+        }
+    }
+
+    for (int v = 0; v < s->num_vars; v++)
+    {
+        if (s->valor[v] == SAT_INDEFINIDO)
+        {
+            s->est.variaveis++;
+            heap_inserir(s, v);
+        }
+    }
+    return 1;
+}
+
+int resolver_grelha_sat(uint8_t *celulas, int bloco, const atomic_int *parar, EstatisticasSat *estatisticas)
+{
+    if (bloco < NXN_MIN_BLOCO || bloco > NXN_MAX_BLOCO)
+        return 0;
+
+    int lado = bloco * bloco;
+    int n = lado * lado;
+    Sat s;
+    int resultado = 0;
+
+    if (alocar(&s, n * lado))
+    {
+        s.parar = parar;
+        if (codificar(&s, celulas, bloco) && pesquisar(&s) == 1)
+        {
+            for (int pos = 0; pos < n; pos++)
+                for (int d = 1; d <= lado; d++)
+                    if (s.valor[pos * lado + d - 1] == SAT_VERDADEIRO)
+                        celulas[pos] = (uint8_t)d;
+            resultado = 1;
+        }
+    }
+
+    if (estatisticas)
+        *estatisticas = s.est;
+    libertar(&s);
+    return resultado;
+}
+
+int resolver_sudoku_sat(Tabuleiro *tabuleiro)
+{
+    return resolver_grelha_sat(tabuleiro->celulas, 3, NULL, NULL);
+}
+
+int resolver_sudoku_sat_cancelavel(Tabuleiro *tabuleiro, const atomic_int *parar)
+{
+    return resolver_grelha_sat(tabuleiro->celulas, 3, parar, NULL);
+}
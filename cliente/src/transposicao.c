@@ -0,0 +1,83 @@
+// cliente/src/transposicao.c - Tabela de transposição de posições refutadas
+//
+// Tabela de endereçamento direto, sem locks: a entrada de uma chave é dada
+// pelos seus bits baixos e guarda a chave inteira, lida e escrita com uma
+// única operação atómica de 64 bits. Escritas concorrentes na mesma entrada
+// ficam com uma delas (a outra posição perde-se, o que só custa um
+// acerto futuro). Uma leitura nunca vê meia chave, logo um acerto é sempre
+// uma posição de facto registada (colisões de 64 bits são desprezáveis).
+#include <stdlib.h>
+#include <stdatomic.h>
+#include "transposicao.h"
+
+#define TRANSPOSICAO_MAX_BITS 30
+
+// 0 marca uma entrada livre; uma chave 0 é guardada como 1
+#define CHAVE_LIVRE 0
+
+struct TabelaTransposicao
+{
+    _Atomic uint64_t *entradas;
+    uint64_t mascara;     // capacidade - 1
+    atomic_long ocupadas; // Entradas que deixaram de estar livres
+};
+
+static inline uint64_t chave_guardada(uint64_t chave)
+{
+    return chave == CHAVE_LIVRE ? 1 : chave;
+}
+
+TabelaTransposicao *transposicao_criar(int bits)
+{
+    if (bits <= 0)
+        return NULL;
+    if (bits > TRANSPOSICAO_MAX_BITS)
+        bits = TRANSPOSICAO_MAX_BITS;
+
+    TabelaTransposicao *tt = malloc(sizeof(TabelaTransposicao));
+    if (!tt)
+        return NULL;
+
+    uint64_t capacidade = 1ull << bits;
+    tt->entradas = calloc(capacidade, sizeof(_Atomic uint64_t));
+    if (!tt->entradas)
+    {
+        free(tt);
+        return NULL;
+    }
+    tt->mascara = capacidade - 1;
+    atomic_init(&tt->ocupadas, 0);
+    return tt;
+}
+
+void transposicao_destruir(TabelaTransposicao *tt)
+{
+    if (!tt)
+        return;
+    free(tt->entradas);
+    free(tt);
+}
+
+int transposicao_contem(const TabelaTransposicao *tt, uint64_t chave)
+{
+    uint64_t guardada = chave_guardada(chave);
+    return atomic_load_explicit(&tt->entradas[guardada & tt->mascara], memory_order_relaxed) == guardada;
+}
+
+void transposicao_registar(TabelaTransposicao *tt, uint64_t chave)
+{
+    uint64_t guardada = chave_guardada(chave);
+    uint64_t anterior = atomic_exchange_explicit(&tt->entradas[guardada & tt->mascara], guardada, memory_order_relaxed);
+    if (anterior == CHAVE_LIVRE)
+        atomic_fetch_add_explicit(&tt->ocupadas, 1, memory_order_relaxed);
+}
+
+long transposicao_capacidade(const TabelaTransposicao *tt)
+{
+    return tt ? (long)(tt->mascara + 1) : 0;
+}
+
+long transposicao_ocupadas(const TabelaTransposicao *tt)
+{
+    return tt ? atomic_load(&tt->ocupadas) : 0;
+}
@@ -10,8 +10,9 @@
 #include "protocolo.h"
 #include "logs_cliente.h"
 #include "solver.h"
+#include "verificacao.h"
 
-void imprimirTabuleiroCliente(const char *tabuleiro)
+void imprimirTabuleiroCliente(const Tabuleiro *tabuleiro)
 {
     printf("\033[36m");
     printf("    ┌───────┬───────┬───────┐\n");
@@ -21,8 +22,8 @@ void imprimirTabuleiroCliente(const char *tabuleiro)
         printf("    │");
         for (int j = 0; j < 9; j++)
         {
-            int idx = i * 9 + j;
-            char celula = (tabuleiro[idx] == '0') ? '.' : tabuleiro[idx];
+            int num = TAB_CELULA(tabuleiro, i, j);
+            char celula = (num == 0) ? '.' : (char)('0' + num);
 
             if (celula == '.')
                 printf(" \033[2m%c\033[0m\033[36m", celula);
@@ -44,6 +45,52 @@ void imprimirTabuleiroCliente(const char *tabuleiro)
     printf("\033[0m");
 }
 
+// Linha horizontal de um tabuleiro N×N: esquerda, junção e direita
+static void imprimirSeparadorNxN(int bloco, const char *esq, const char *meio, const char *dir)
+{
+    printf("    %s", esq);
+    for (int b = 0; b < bloco; b++)
+    {
+        for (int k = 0; k < 2 * bloco + 1; k++)
+            printf("─");
+        printf("%s", b == bloco - 1 ? dir : meio);
+    }
+    printf("\n");
+}
+
+// Tabuleiros 16x16 e 25x25 (valores acima de 9 como letras, A = 10)
+static void imprimirTabuleiroNxN(const TabuleiroNxN *tabuleiro, int bloco)
+{
+    int lado = nxn_lado(bloco);
+
+    printf("\033[36m");
+    imprimirSeparadorNxN(bloco, "┌", "┬", "┐");
+
+    for (int i = 0; i < lado; i++)
+    {
+        printf("    │");
+        for (int j = 0; j < lado; j++)
+        {
+            char celula = nxn_caractere(tabuleiro->celulas[i * lado + j]);
+
+            if (celula == '.')
+                printf(" \033[2m%c\033[0m\033[36m", celula);
+            else
+                printf(" \033[1;33m%c\033[0m\033[36m", celula);
+
+            if (j % bloco == bloco - 1)
+                printf(" │");
+        }
+        printf("\n");
+
+        if (i % bloco == bloco - 1 && i != lado - 1)
+            imprimirSeparadorNxN(bloco, "├", "┼", "┤");
+    }
+
+    imprimirSeparadorNxN(bloco, "└", "┴", "┘");
+    printf("\033[0m");
+}
+
 // Atualiza a interface durante a resolução
 void atualizarUICliente(MensagemSudoku *msg, struct timespec horaInicio)
 {
@@ -74,7 +121,9 @@ void atualizarUICliente(MensagemSudoku *msg, struct timespec horaInicio)
     printf("\n");
 
     // Reutiliza a função de imprimir o tabuleiro
-    imprimirTabuleiroCliente(msg->tabuleiro);
+    Tabuleiro tabuleiro;
+    tabuleiro_descompactar(&msg->tabuleiro, &tabuleiro);
+    imprimirTabuleiroCliente(&tabuleiro);
 }
 
 /* * Função principal do cliente.
@@ -84,6 +133,369 @@ void atualizarUICliente(MensagemSudoku *msg, struct timespec horaInicio)
  * Gere o fluxo de comunicação com o servidor.
  * Permite jogar múltiplos jogos consecutivos.
  */
+// Jogo 16x16 ou 25x25: recebe o tabuleiro que segue a mensagem
+// ENVIAR_JOGO, resolve-o localmente (sem validação remota de blocos) e
+// envia a solução da mesma forma. Devolve 0 se não receber o tabuleiro ou
+// se não tiver uma solução que passe a verificação local.
+static int jogarJogoNxN(int sockfd, int idCliente, const MensagemSudoku *msg_jogo, double *tempo_resolucao)
+{
+    int bloco = msg_jogo->tamanhoBloco;
+    int lado = nxn_lado(bloco);
+    int celulas = nxn_celulas(bloco);
+    char msg_log[256];
+
+    TabuleiroNxN tabuleiro;
+    memset(&tabuleiro, 0, sizeof(tabuleiro));
+    if (readn(sockfd, (char *)tabuleiro.celulas, celulas) != celulas)
+    {
+        printf("Cliente: Erro ao receber o tabuleiro %dx%d\n", lado, lado);
+        registarEventoCliente(EVTC_ERRO, "Erro ao receber o tabuleiro N×N");
+        return 0;
+    }
+
+    int pistas = 0;
+    for (int i = 0; i < celulas; i++)
+        if (tabuleiro.celulas[i])
+            pistas++;
+
+    printf("\033[32mRecebido!\033[0m (%dx%d, %d pistas)\n", lado, lado, pistas);
+    snprintf(msg_log, sizeof(msg_log),
+             "Jogo #%d recebido (%dx%d, %d células preenchidas, %d vazias)",
+             msg_jogo->idJogo, lado, lado, pistas, celulas - pistas);
+    registarEventoCliente(EVTC_JOGO_RECEBIDO, msg_log);
+
+    struct timespec horaInicio;
+    clock_gettime(CLOCK_MONOTONIC, &horaInicio);
+
+    printf("\n\033[1;33m╔═══════════════════════════════════════════╗\n");
+    printf("║     TABULEIRO RECEBIDO - JOGO #%d       ║\n", msg_jogo->idJogo);
+    printf("╚═══════════════════════════════════════════╝\033[0m\n\n");
+    imprimirTabuleiroNxN(&tabuleiro, bloco);
+    printf("\n");
+
+    printf("\033[33mA resolver...\033[0m ");
+    fflush(stdout);
+
+    TabuleiroNxN puzzle = tabuleiro;
+    int resolvido = resolver_sudoku_nxn(&tabuleiro, bloco);
+    if (resolvido)
+        printf("\033[32m✓ Resolvido!\033[0m\n");
+    else
+        printf("\033[31m✗ Impossível resolver!\033[0m\n");
+
+    // Verificação local, como no 9x9: tentar o outro motor N×N antes de desistir
+    ResultadoVerificacaoLocal verificacao = verificar_solucao_local_nxn(&tabuleiro, &puzzle, bloco);
+    if (verificacao != VERIFICACAO_OK)
+    {
+        const char *motor_recurso = "";
+
+        printf("\033[33mVerificação local falhou (%s): a tentar outro motor...\033[0m ",
+               nome_resultado_verificacao(verificacao));
+        fflush(stdout);
+
+        tabuleiro = puzzle;
+        resolvido = resolver_sudoku_nxn_recurso(&tabuleiro, bloco, &motor_recurso);
+        verificacao = verificar_solucao_local_nxn(&tabuleiro, &puzzle, bloco);
+
+        snprintf(msg_log, sizeof(msg_log),
+                 "Jogo #%d: solução falhou a verificação local; motor %s %s",
+                 msg_jogo->idJogo, motor_recurso,
+                 verificacao == VERIFICACAO_OK ? "resolveu" : "também falhou");
+        registarEventoCliente(EVTC_ERRO, msg_log);
+
+        if (verificacao == VERIFICACAO_OK)
+            printf("\033[32m✓ Resolvido (%s)!\033[0m\n", motor_recurso);
+        else
+            printf("\033[31m✗ %s\033[0m\n", resolvido ? "Solução inválida!" : "Impossível resolver!");
+    }
+    printf("\n");
+    imprimirTabuleiroNxN(&tabuleiro, bloco);
+
+    // Sem solução válida não há nada a enviar: termina a sessão (ver str_cli)
+    if (verificacao != VERIFICACAO_OK)
+    {
+        printf("\033[31mSolução não enviada (verificação local: %s).\033[0m\n",
+               nome_resultado_verificacao(verificacao));
+        snprintf(msg_log, sizeof(msg_log),
+                 "Jogo #%d: solução não enviada (verificação local: %s)",
+                 msg_jogo->idJogo, nome_resultado_verificacao(verificacao));
+        registarEventoCliente(EVTC_SOLUCAO_INCORRETA, msg_log);
+
+        printf("\nA terminar sessão...\n");
+        return 0;
+    }
+
+    struct timespec fim;
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+    *tempo_resolucao = (fim.tv_sec - horaInicio.tv_sec) +
+                       (fim.tv_nsec - horaInicio.tv_nsec) / 1e9;
+
+    printf("\033[33mA enviar solução...\033[0m ");
+    fflush(stdout);
+
+    snprintf(msg_log, sizeof(msg_log),
+             "Solução enviada para Jogo #%d (%dx%d, tempo: %.3fs)",
+             msg_jogo->idJogo, lado, lado, *tempo_resolucao);
+    registarEventoCliente(EVTC_SOLUCAO_ENVIADA, msg_log);
+
+    MensagemSudoku msg_enviar;
+    bzero(&msg_enviar, sizeof(MensagemSudoku));
+    msg_enviar.tipo = ENVIAR_SOLUCAO;
+    msg_enviar.idCliente = idCliente;
+    msg_enviar.idJogo = msg_jogo->idJogo;
+    msg_enviar.tamanhoBloco = bloco;
+
+    if (writen(sockfd, (char *)&msg_enviar, sizeof(MensagemSudoku)) != sizeof(MensagemSudoku) ||
+        writen(sockfd, (char *)tabuleiro.celulas, celulas) != celulas)
+        err_dump("str_cli: erro ao enviar solução");
+
+    return 1;
+}
+
+// Jogo 9x9: resolve o tabuleiro de ENVIAR_JOGO (com validação remota de
+// blocos) e envia a solução. Guarda em msg_solucao_visual a solução para a
+// UI e em horaInicio o início da resolução. Devolve 0 se a sessão tiver de
+// terminar (jogo ganho por outro cliente ou sem solução válida).
+static int jogarJogo9x9(int sockfd, int idCliente, const MensagemSudoku *msg_jogo, double *tempo_resolucao,
+                        MensagemSudoku *msg_solucao_visual, struct timespec *horaInicio)
+{
+    MensagemSudoku msg_enviar;
+    char msg_log[256];
+
+    // Desempacotar o tabuleiro recebido (41 bytes -> 81 células)
+    Tabuleiro tabuleiro_jogo;
+    tabuleiro_descompactar(&msg_jogo->tabuleiro, &tabuleiro_jogo);
+
+    // Contar células preenchidas
+    int celulas_preenchidas = tabuleiro_preenchidas(&tabuleiro_jogo);
+
+    printf("\033[32mRecebido!\033[0m (%d pistas)\n", celulas_preenchidas);
+    snprintf(msg_log, sizeof(msg_log),
+             "Jogo #%d recebido (%d células preenchidas, %d vazias)",
+             msg_jogo->idJogo, celulas_preenchidas, 81 - celulas_preenchidas);
+    registarEventoCliente(EVTC_JOGO_RECEBIDO, msg_log);
+
+    // CAPTURAR A HORA DE INÍCIO
+    clock_gettime(CLOCK_MONOTONIC, horaInicio);
+
+    // *** MOSTRAR O TABULEIRO ORIGINAL ANTES DA RESOLUÇÃO ***
+    printf("\n\033[1;33m╔═══════════════════════════════════════════╗\n");
+    printf("║     TABULEIRO RECEBIDO - JOGO #%d       ║\n", msg_jogo->idJogo);
+    printf("╚═══════════════════════════════════════════╝\033[0m\n\n");
+    imprimirTabuleiroCliente(&tabuleiro_jogo);
+    printf("\n");
+
+    // ----- PASSO 3: Resolver o jogo (ALGORITMO REAL) -----
+    Tabuleiro minha_solucao = tabuleiro_jogo;
+
+    printf("\033[33mA resolver...\033[0m ");
+    fflush(stdout);
+
+    int resolvido = resolver_sudoku(&minha_solucao, sockfd, idCliente);
+
+    // O servidor respondeu JOGO_TERMINADO a uma validação: a pesquisa
+    // foi cancelada e o servidor já fechou a ligação deste jogo
+    SolverContext *contexto = solver_contexto_global();
+    if (!resolvido && solver_contexto_motivo(contexto) == PARAGEM_JOGO_TERMINADO)
+    {
+        int vencedor = solver_contexto_vencedor(contexto);
+
+        printf("\n\n");
+        printf("\033[1;31m╔═══════════════════════════════════════════╗\n");
+        printf("║           JOGO TERMINADO                  ║\n");
+        printf("╚═══════════════════════════════════════════╝\033[0m\n");
+        printf("\033[33mCliente #%d venceu primeiro!\033[0m\n", vencedor);
+        printf("\033[31mResultado: DERROTA\033[0m\n");
+
+        char log_derrota[256];
+        snprintf(log_derrota, sizeof(log_derrota),
+                 "Derrotado - Cliente %d ganhou o jogo (pesquisa cancelada)", vencedor);
+        registarEventoCliente(EVTC_JOGO_PERDIDO, log_derrota);
+
+        printf("\nA terminar sessão...\n");
+        return 0;
+    }
+
+    if (resolvido)
+    {
+        printf("\033[32m✓ Resolvido!\033[0m\n");
+    }
+    else
+    {
+        printf("\033[31m✗ Impossível resolver!\033[0m\n");
+    }
+
+    // Verificação local: uma solução que falha as regras ou muda pistas
+    // seria recusada pelo servidor. Tentar outro motor antes de desistir.
+    ResultadoVerificacaoLocal verificacao = verificar_solucao_local(&minha_solucao, &tabuleiro_jogo);
+    if (verificacao != VERIFICACAO_OK)
+    {
+        const char *motor_recurso = "";
+
+        printf("\033[33mVerificação local falhou (%s): a tentar outro motor...\033[0m ",
+               nome_resultado_verificacao(verificacao));
+        fflush(stdout);
+
+        minha_solucao = tabuleiro_jogo;
+        resolvido = resolver_sudoku_recurso(&minha_solucao, &motor_recurso);
+        verificacao = verificar_solucao_local(&minha_solucao, &tabuleiro_jogo);
+
+        snprintf(msg_log, sizeof(msg_log),
+                 "Jogo #%d: solução falhou a verificação local; motor %s %s",
+                 msg_jogo->idJogo, motor_recurso,
+                 verificacao == VERIFICACAO_OK ? "resolveu" : "também falhou");
+        registarEventoCliente(EVTC_ERRO, msg_log);
+
+        if (verificacao == VERIFICACAO_OK)
+            printf("\033[32m✓ Resolvido (%s)!\033[0m\n", motor_recurso);
+        else
+            printf("\033[31m✗ %s\033[0m\n", resolvido ? "Solução inválida!" : "Impossível resolver!");
+    }
+
+    // Sem solução válida não há nada a enviar: o servidor só aceita
+    // validações ou ENVIAR_SOLUCAO, pelo que a sessão termina aqui
+    if (verificacao != VERIFICACAO_OK)
+    {
+        printf("\033[31mSolução não enviada (verificação local: %s).\033[0m\n",
+               nome_resultado_verificacao(verificacao));
+        snprintf(msg_log, sizeof(msg_log),
+                 "Jogo #%d: solução não enviada (verificação local: %s)",
+                 msg_jogo->idJogo, nome_resultado_verificacao(verificacao));
+        registarEventoCliente(EVTC_SOLUCAO_INCORRETA, msg_log);
+
+        printf("\nA terminar sessão...\n");
+        return 0;
+    }
+
+    // ----- PASSO 4: Enviar a solução -----
+    // Atualizar UI com a solução encontrada
+    memcpy(msg_solucao_visual, msg_jogo, sizeof(MensagemSudoku));
+    tabuleiro_compactar(&minha_solucao, &msg_solucao_visual->tabuleiro);
+    atualizarUICliente(msg_solucao_visual, *horaInicio);
+
+    printf("\033[33mA enviar solução...\033[0m ");
+    fflush(stdout);
+
+    struct timespec fim;
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+    *tempo_resolucao = (fim.tv_sec - horaInicio->tv_sec) +
+                       (fim.tv_nsec - horaInicio->tv_nsec) / 1e9;
+
+    // Contar células preenchidas na solução
+    int celulas_sol = tabuleiro_preenchidas(&minha_solucao);
+
+    snprintf(msg_log, sizeof(msg_log),
+             "Solução enviada para Jogo #%d (%d células, tempo: %.3fs)",
+             msg_jogo->idJogo, celulas_sol, *tempo_resolucao);
+    registarEventoCliente(EVTC_SOLUCAO_ENVIADA, msg_log);
+
+    bzero(&msg_enviar, sizeof(MensagemSudoku));
+    msg_enviar.tipo = ENVIAR_SOLUCAO;
+    msg_enviar.idCliente = idCliente;
+    msg_enviar.idJogo = msg_jogo->idJogo;
+    msg_enviar.tabuleiro = msg_solucao_visual->tabuleiro;
+
+    if (writen(sockfd, (char *)&msg_enviar, sizeof(MensagemSudoku)) != sizeof(MensagemSudoku))
+        err_dump("str_cli: erro ao enviar solução");
+
+    return 1;
+}
+
+// Lê a resposta do servidor à solução enviada e mostra o resultado. No
+// 9x9 redesenha antes o tabuleiro resolvido (msg_solucao_visual a NULL no
+// N×N). Devolve 1 se o jogo foi ganho, 0 se não, e -1 se a sessão tiver de
+// terminar (timeout ou JOGO_TERMINADO).
+static int receberResultado(int sockfd, const MensagemSudoku *msg_jogo, double tempo_resolucao,
+                            MensagemSudoku *msg_solucao_visual, const struct timespec *horaInicio)
+{
+    MensagemSudoku msg_receber;
+    char msg_log[256];
+
+    int n = readn(sockfd, (char *)&msg_receber, sizeof(MensagemSudoku));
+    if (n != sizeof(MensagemSudoku))
+    {
+        // Verificar se foi timeout
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            printf("[TIMEOUT] Servidor não respondeu a tempo.\n");
+            registarEventoCliente(EVTC_ERRO, "Timeout ao aguardar resultado do servidor");
+            return -1;
+        }
+        err_dump("str_cli: erro ao receber resultado");
+    }
+
+    snprintf(msg_log, sizeof(msg_log),
+             "Resultado recebido do servidor para Jogo #%d",
+             msg_jogo->idJogo);
+    registarEventoCliente(EVTC_RESULTADO_RECEBIDO, msg_log);
+
+    // Mostrar o resultado final com o tabuleiro PREENCHIDO (só no 9x9)
+    if (msg_solucao_visual)
+        atualizarUICliente(msg_solucao_visual, *horaInicio);
+
+    // VERIFICAR SE JOGO TERMINOU (OUTRO CLIENTE GANHOU)
+    if (msg_receber.tipo == JOGO_TERMINADO)
+    {
+        printf("\n\n");
+        printf("\033[1;31m╔═══════════════════════════════════════════╗\n");
+        printf("║           JOGO TERMINADO                  ║\n");
+        printf("╚═══════════════════════════════════════════╝\033[0m\n");
+        printf("\033[33mCliente #%d venceu primeiro!\033[0m\n", msg_receber.idCliente);
+        printf("\033[31mResultado: DERROTA\033[0m\n");
+
+        char log_derrota[256];
+        snprintf(log_derrota, sizeof(log_derrota),
+                 "Derrotado - Cliente %d ganhou o jogo", msg_receber.idCliente);
+        registarEventoCliente(EVTC_JOGO_PERDIDO, log_derrota);
+
+        // Não perguntar se quer jogar novamente
+        printf("\nA terminar sessão...\n");
+        return -1;
+    }
+
+    if (msg_receber.tipo == RESPOSTA_SOLUCAO)
+    {
+        printf("\033[32mRecebido!\033[0m\n\n");
+
+        if (strcmp(msg_receber.resposta, "Certo") == 0)
+        {
+            printf("\033[1;32m╔═══════════════════════════════════════════╗\n");
+            printf("║              VITÓRIA!                     ║\n");
+            printf("╚═══════════════════════════════════════════╝\033[0m\n");
+        }
+        else
+        {
+            printf("\033[1;31m╔═══════════════════════════════════════════╗\n");
+            printf("║           SOLUÇÃO INCORRETA               ║\n");
+            printf("╚═══════════════════════════════════════════╝\033[0m\n");
+        }
+
+        if (strcmp(msg_receber.resposta, "Certo") == 0)
+        {
+            snprintf(msg_log, sizeof(msg_log),
+                     "SOLUÇÃO CORRETA! Jogo #%d resolvido em %.3fs",
+                     msg_jogo->idJogo, tempo_resolucao);
+            registarEventoCliente(EVTC_SOLUCAO_CORRETA, msg_log);
+            return 1;
+        }
+        else
+        {
+            snprintf(msg_log, sizeof(msg_log),
+                     "SOLUÇÃO INCORRETA - Jogo #%d (tempo: %.3fs)",
+                     msg_jogo->idJogo, tempo_resolucao);
+            registarEventoCliente(EVTC_SOLUCAO_INCORRETA, msg_log);
+        }
+    }
+    else
+    {
+        printf("Cliente: Erro, esperava uma resposta (tipo 4) e recebi tipo %d\n", msg_receber.tipo);
+        snprintf(msg_log, sizeof(msg_log), "Erro: tipo de resposta inesperado %d", msg_receber.tipo);
+        registarEventoCliente(EVTC_ERRO, msg_log);
+    }
+
+    return 0;
+}
+
 void str_cli(FILE *fp, int sockfd, int idCliente)
 {
     (void)fp; // Parâmetro não usado nesta implementação
@@ -147,173 +559,32 @@ void str_cli(FILE *fp, int sockfd, int idCliente)
             return;
         }
 
-        // Contar células preenchidas
-        int celulas_preenchidas = 0;
-        for (int i = 0; i < 81; i++)
-        {
-            if (msg_receber.tabuleiro[i] != '0')
-                celulas_preenchidas++;
-        }
-
-        printf("\033[32mRecebido!\033[0m (%d pistas)\n", celulas_preenchidas);
-        snprintf(msg_log, sizeof(msg_log),
-                 "Jogo #%d recebido (%d células preenchidas, %d vazias)",
-                 msg_receber.idJogo, celulas_preenchidas, 81 - celulas_preenchidas);
-        registarEventoCliente(EVTC_JOGO_RECEBIDO, msg_log);
-
         // *** CORREÇÃO: Copia a mensagem do jogo para um local seguro ***
         memcpy(&msg_jogo_original, &msg_receber, sizeof(MensagemSudoku));
 
-        // CAPTURAR A HORA DE INÍCIO
+        // ----- PASSOS 3 e 4: Resolver o jogo e enviar a solução -----
+        double tempo_resolucao;
+        MensagemSudoku msg_solucao_visual;
         struct timespec horaInicio;
-        clock_gettime(CLOCK_MONOTONIC, &horaInicio);
+        int grande = msg_jogo_original.tamanhoBloco == 4 || msg_jogo_original.tamanhoBloco == 5;
+        int enviada;
 
-        // *** MOSTRAR O TABULEIRO ORIGINAL ANTES DA RESOLUÇÃO ***
-        printf("\n\033[1;33m╔═══════════════════════════════════════════╗\n");
-        printf("║     TABULEIRO RECEBIDO - JOGO #%d       ║\n", msg_jogo_original.idJogo);
-        printf("╚═══════════════════════════════════════════╝\033[0m\n\n");
-        imprimirTabuleiroCliente(msg_jogo_original.tabuleiro);
-        printf("\n");
-
-        // ----- PASSO 3: Resolver o jogo (ALGORITMO REAL) -----
-        char minha_solucao[82];
-        strncpy(minha_solucao, msg_jogo_original.tabuleiro, sizeof(minha_solucao) - 1);
-        minha_solucao[sizeof(minha_solucao) - 1] = '\0';
-
-        printf("\033[33mA resolver...\033[0m ");
-        fflush(stdout);
-
-        if (resolver_sudoku(minha_solucao, sockfd, idCliente))
-        {
-            printf("\033[32m✓ Resolvido!\033[0m\n");
-        }
+        if (grande)
+            // 16x16 / 25x25: tabuleiro a seguir à mensagem, resolvido à parte
+            enviada = jogarJogoNxN(sockfd, idCliente, &msg_jogo_original, &tempo_resolucao);
         else
-        {
-            printf("\033[31m✗ Impossível resolver!\033[0m\n");
-        }
-
-        // ----- PASSO 4: Enviar a solução -----
-        // Atualizar UI com a solução encontrada
-        MensagemSudoku msg_solucao_visual;
-        memcpy(&msg_solucao_visual, &msg_jogo_original, sizeof(MensagemSudoku));
-        strncpy(msg_solucao_visual.tabuleiro, minha_solucao, 81);
-        atualizarUICliente(&msg_solucao_visual, horaInicio);
-
-        printf("\033[33mA enviar solução...\033[0m ");
-        fflush(stdout);
-
-        struct timespec fim;
-        clock_gettime(CLOCK_MONOTONIC, &fim);
-        double tempo_resolucao = (fim.tv_sec - horaInicio.tv_sec) +
-                                 (fim.tv_nsec - horaInicio.tv_nsec) / 1e9;
-
-        // Contar células preenchidas na solução
-        int celulas_sol = 0;
-        for (int i = 0; i < 81; i++)
-        {
-            if (minha_solucao[i] != '0')
-                celulas_sol++;
-        }
-
-        snprintf(msg_log, sizeof(msg_log),
-                 "Solução enviada para Jogo #%d (%d células, tempo: %.3fs)",
-                 msg_jogo_original.idJogo, celulas_sol, tempo_resolucao);
-        registarEventoCliente(EVTC_SOLUCAO_ENVIADA, msg_log);
-
-        bzero(&msg_enviar, sizeof(MensagemSudoku));
-        msg_enviar.tipo = ENVIAR_SOLUCAO;
-        msg_enviar.idCliente = idCliente;
-        msg_enviar.idJogo = msg_jogo_original.idJogo; // Usa o idJogo da cópia
-        strncpy(msg_enviar.tabuleiro, minha_solucao, sizeof(msg_enviar.tabuleiro) - 1);
-        msg_enviar.tabuleiro[sizeof(msg_enviar.tabuleiro) - 1] = '\0';
-
-        if (writen(sockfd, (char *)&msg_enviar, sizeof(MensagemSudoku)) != sizeof(MensagemSudoku))
-            err_dump("str_cli: erro ao enviar solução");
+            enviada = jogarJogo9x9(sockfd, idCliente, &msg_jogo_original, &tempo_resolucao,
+                                   &msg_solucao_visual, &horaInicio);
+        if (!enviada)
+            return;
 
         // ----- PASSO 5: Receber o resultado -----
-        // msg_receber é AGORA USADO SÓ PARA A RESPOSTA
-        n = readn(sockfd, (char *)&msg_receber, sizeof(MensagemSudoku));
-        if (n != sizeof(MensagemSudoku))
-        {
-            // Verificar se foi timeout
-            if (errno == EAGAIN || errno == EWOULDBLOCK)
-            {
-                printf("[TIMEOUT] Servidor não respondeu a tempo.\n");
-                registarEventoCliente(EVTC_ERRO, "Timeout ao aguardar resultado do servidor");
-                return;
-            }
-            err_dump("str_cli: erro ao receber resultado");
-        }
-
-        snprintf(msg_log, sizeof(msg_log),
-                 "Resultado recebido do servidor para Jogo #%d",
-                 msg_jogo_original.idJogo);
-        registarEventoCliente(EVTC_RESULTADO_RECEBIDO, msg_log);
-
-        // Mostrar o resultado final
-        // *** CORREÇÃO: Usa a cópia segura (msg_jogo_original) para desenhar a UI ***
-        // Mas queremos mostrar o tabuleiro PREENCHIDO, não o original
-        atualizarUICliente(&msg_solucao_visual, horaInicio);
-
-        // VERIFICAR SE JOGO TERMINOU (OUTRO CLIENTE GANHOU)
-        if (msg_receber.tipo == JOGO_TERMINADO)
-        {
-            printf("\n\n");
-            printf("\033[1;31m╔═══════════════════════════════════════════╗\n");
-            printf("║           JOGO TERMINADO                  ║\n");
-            printf("╚═══════════════════════════════════════════╝\033[0m\n");
-            printf("\033[33mCliente #%d venceu primeiro!\033[0m\n", msg_receber.idCliente);
-            printf("\033[31mResultado: DERROTA\033[0m\n");
-
-            char log_derrota[256];
-            snprintf(log_derrota, sizeof(log_derrota),
-                     "Derrotado - Cliente %d ganhou o jogo", msg_receber.idCliente);
-            registarEventoCliente(EVTC_JOGO_PERDIDO, log_derrota);
-
-            // Não perguntar se quer jogar novamente
-            printf("\nA terminar sessão...\n");
-            return; // Sair da função str_cli
-        }
-
-        if (msg_receber.tipo == RESPOSTA_SOLUCAO)
-        {
-            printf("\033[32mRecebido!\033[0m\n\n");
-
-            if (strcmp(msg_receber.resposta, "Certo") == 0)
-            {
-                printf("\033[1;32m╔═══════════════════════════════════════════╗\n");
-                printf("║              VITÓRIA!                     ║\n");
-                printf("╚═══════════════════════════════════════════╝\033[0m\n");
-            }
-            else
-            {
-                printf("\033[1;31m╔═══════════════════════════════════════════╗\n");
-                printf("║           SOLUÇÃO INCORRETA               ║\n");
-                printf("╚═══════════════════════════════════════════╝\033[0m\n");
-            }
-
-            if (strcmp(msg_receber.resposta, "Certo") == 0)
-            {
-                jogos_ganhos++; // Incrementar contador de vitórias
-                snprintf(msg_log, sizeof(msg_log),
-                         "SOLUÇÃO CORRETA! Jogo #%d resolvido em %.3fs",
-                         msg_jogo_original.idJogo, tempo_resolucao);
-                registarEventoCliente(EVTC_SOLUCAO_CORRETA, msg_log);
-            }
-            else
-            {
-                snprintf(msg_log, sizeof(msg_log),
-                         "SOLUÇÃO INCORRETA - Jogo #%d (tempo: %.3fs)",
-                         msg_jogo_original.idJogo, tempo_resolucao);
-                registarEventoCliente(EVTC_SOLUCAO_INCORRETA, msg_log);
-            }
-        }
-        else
-        {
-            printf("Cliente: Erro, esperava uma resposta (tipo 4) e recebi tipo %d\n", msg_receber.tipo);
-            snprintf(msg_log, sizeof(msg_log), "Erro: tipo de resposta inesperado %d", msg_receber.tipo);
-            registarEventoCliente(EVTC_ERRO, msg_log);
-        }
+        int resultado = receberResultado(sockfd, &msg_jogo_original, tempo_resolucao,
+                                         grande ? NULL : &msg_solucao_visual, &horaInicio);
+        if (resultado < 0)
+            return;
+        if (resultado > 0)
+            jogos_ganhos++; // Incrementar contador de vitórias
 
         printf("\n\033[36m┌─────────────────────────────────────────┐\n");
         printf("│      ESTATÍSTICAS DA SESSÃO             │\n");
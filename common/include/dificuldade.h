@@ -0,0 +1,51 @@
+/*
+ * common/include/dificuldade.h
+ *
+ * Classificação da dificuldade de um puzzle pelas técnicas humanas
+ * necessárias para o resolver e pelo esforço de pesquisa medido.
+ *
+ * O puzzle é resolvido só com lógica, aplicando sempre a técnica mais
+ * simples que faça progresso; o nível é a técnica mais difícil que foi
+ * preciso usar. Se a lógica encravar antes do fim o nível é
+ * NIVEL_TENTATIVA (é preciso adivinhar). O esforço é o número de nós de
+ * um backtracking MRV sem propagação, que separa puzzles do mesmo nível.
+ */
+
+#ifndef DIFICULDADE_H
+#define DIFICULDADE_H
+
+#include "tabuleiro.h"
+
+// Por ordem crescente de dificuldade: o nível de um puzzle é o mais alto usado
+typedef enum
+{
+    NIVEL_NAO_CLASSIFICADO = 0,
+    NIVEL_SINGLE_OCULTO = 1, // Dígito que só cabe numa célula da unidade
+    NIVEL_SINGLE_NU = 2,     // Célula com um único candidato
+    NIVEL_BLOQUEADOS = 3,    // Candidatos bloqueados (pointing / claiming)
+    NIVEL_PARES = 4,         // Pares nus e ocultos
+    NIVEL_TRIPLOS = 5,       // Triplos nus e ocultos
+    NIVEL_X_WING = 6,
+    NIVEL_XY_WING = 7,
+    NIVEL_SWORDFISH = 8,
+    NIVEL_TENTATIVA = 9 // A lógica acima não chega: é preciso adivinhar
+} NivelDificuldade;
+
+#define NUM_NIVEIS_DIFICULDADE 10
+
+typedef struct
+{
+    NivelDificuldade nivel;
+    int usos[NUM_NIVEIS_DIFICULDADE]; // Quantas vezes cada técnica fez progresso
+    int preenchidas_logica;           // Células resolvidas só com lógica
+    long nos;                         // Esforço: nós do backtracking MRV sem propagação
+} Classificacao;
+
+// Classifica o puzzle. Devolve 0 se as pistas forem contraditórias ou o
+// puzzle não tiver solução (classificação fica NIVEL_NAO_CLASSIFICADO).
+int classificar_puzzle(const Tabuleiro *puzzle, Classificacao *c);
+
+// Nome curto do nível ("single oculto", "x-wing", ...)
+const char *nome_nivel_dificuldade(NivelDificuldade nivel);
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef MOTOR_SUDOKU_H
+#define MOTOR_SUDOKU_H
+
+#include <stdint.h>
+#include "tabuleiro.h"
+
+// Núcleo de pesquisa partilhado pelo solver do cliente e pelo servidor:
+// máscaras de candidatos, lista de células vazias, escolha da célula onde
+// ramificar e propagação de singles com trilho para desfazer.
+
+// Heurística de escolha da célula onde o backtracking ramifica
+typedef enum
+{
+    HEURISTICA_PRIMEIRA = 0, // Primeira célula vazia por ordem de linhas
+    HEURISTICA_MRV = 1       // Célula com menos candidatos (Minimum Remaining Values)
+} HeuristicaCelula;
+
+// Máscaras de ocupação: o bit (d - 1) está ligado se o dígito d já existe
+// na linha/coluna/bloco. Mantidas de forma incremental ao colocar/retirar
+// números, os candidatos de uma célula saem de um único OR + NOT.
+typedef struct
+{
+    uint16_t linhas[9];
+    uint16_t colunas[9];
+    uint16_t blocos[9];
+} MascarasSudoku;
+
+#define TODOS_DIGITOS 0x1FF
+#define BLOCO_DE(row, col) (((row) / 3) * 3 + (col) / 3)
+
+// Constrói as máscaras a partir do tabuleiro. Devolve 0 se as pistas já
+// estiverem em conflito (tabuleiro impossível).
+int mascaras_inicializar(MascarasSudoku *m, const Tabuleiro *tabuleiro);
+
+static inline uint16_t mascaras_candidatos(const MascarasSudoku *m, int row, int col)
+{
+    return (uint16_t)(~(m->linhas[row] | m->colunas[col] | m->blocos[BLOCO_DE(row, col)]) & TODOS_DIGITOS);
+}
+
+static inline void mascaras_colocar(MascarasSudoku *m, int row, int col, int num)
+{
+    uint16_t bit = (uint16_t)(1u << (num - 1));
+    m->linhas[row] |= bit;
+    m->colunas[col] |= bit;
+    m->blocos[BLOCO_DE(row, col)] |= bit;
+}
+
+static inline void mascaras_retirar(MascarasSudoku *m, int row, int col, int num)
+{
+    uint16_t bit = (uint16_t)~(1u << (num - 1));
+    m->linhas[row] &= bit;
+    m->colunas[col] &= bit;
+    m->blocos[BLOCO_DE(row, col)] &= bit;
+}
+
+// Células vazias guardadas como conjunto esparso: celulas[0..n) são as
+// vazias e posicao[c] é o índice de c em celulas. Retirar troca com a
+// última; como as reposições são feitas pela ordem inversa (trilho),
+// repor é só incrementar n. A escolha da célula percorre apenas as
+// vazias em vez das 81 posições.
+typedef struct
+{
+    int celulas[81];
+    int posicao[81];
+    int n;
+} ListaVazias;
+
+void vazias_inicializar(ListaVazias *v, const Tabuleiro *tabuleiro);
+
+static inline void vazias_retirar(ListaVazias *v, int pos)
+{
+    int i = v->posicao[pos];
+    int ultima = v->celulas[--v->n];
+
+    v->celulas[i] = ultima;
+    v->posicao[ultima] = i;
+    v->celulas[v->n] = pos;
+    v->posicao[pos] = v->n;
+}
+
+// Escolhe a próxima célula onde ramificar.
+// Devolve o número de candidatos dessa célula (0 = beco sem saída)
+// ou -1 se o tabuleiro já não tiver células vazias.
+//
+// PRIMEIRA: primeira célula vazia por ordem de linhas (comportamento original).
+// MRV: célula com menos candidatos; em caso de empate ganha a que tem mais
+// vizinhos vazios na linha/coluna/bloco (mais restritiva para o resto).
+int escolher_celula(const ListaVazias *v, const MascarasSudoku *m, HeuristicaCelula heuristica, int *row, int *col);
+
+// Desfaz as colocações registadas no trilho a partir da posição 'inicio'
+void desfazer_trilho(Tabuleiro *tabuleiro, MascarasSudoku *m, const int *trilho, int *n_trilho, int inicio);
+
+// Preenche células forçadas até não haver mais deduções:
+// - naked single: célula com um único candidato
+// - hidden single: dígito que só cabe numa célula da linha/coluna/bloco
+// Cada colocação fica registada no trilho para poder ser desfeita.
+// Devolve 0 se encontrar uma contradição (célula ou dígito sem lugar).
+int propagar(Tabuleiro *tabuleiro, MascarasSudoku *m, int *trilho, int *n_trilho);
+
+// Prepara as tabelas internas (unidades). Chamar antes de propagar();
+// pode ser chamada várias vezes e de várias threads.
+void motor_sudoku_inicializar(void);
+
+// Conta as soluções do tabuleiro até 'limite' (limite 2 = verificar
+// unicidade) e devolve a contagem (0..limite). Se 'solucao' não for NULL
+// recebe a primeira solução encontrada. Pistas em conflito dão 0.
+int contar_solucoes(const Tabuleiro *tabuleiro, int limite, Tabuleiro *solucao);
+
+#endif
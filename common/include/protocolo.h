@@ -12,16 +12,33 @@
  * 3. Cliente -> Servidor: ENVIAR_SOLUCAO (com tabuleiro resolvido)
  * 4. Servidor -> Cliente: RESPOSTA_SOLUCAO (resultado da verificação)
  *
+ * Durante a resolução o cliente pode pedir validações parciais:
+ * VALIDAR_BLOCO (um bloco 3x3, resposta RESPOSTA_BLOCO) ou
+ * VALIDAR_TABULEIRO (tabuleiro parcial + máscara de unidades a validar,
+ * resposta RESPOSTA_TABULEIRO com a máscara das que não têm erros). Uma
+ * unidade está correta se todos os seus valores preenchidos forem os da
+ * solução. Só em jogos 9x9.
+ *
  * Todas as mensagens usam a estrutura MensagemSudoku que contém:
  * - Tipo de mensagem
  * - IDs de cliente e jogo
- * - Tabuleiro (81 células + terminador)
+ * - Tabuleiro compactado (81 células em 41 bytes, ver tabuleiro.h)
  * - Campo de resposta (para resultados)
+ * - Tamanho de bloco do jogo (3 = 9x9, 4 = 16x16, 5 = 25x25)
+ *
+ * Tabuleiros maiores (tamanhoBloco 4 ou 5) não cabem na mensagem: em
+ * ENVIAR_JOGO e ENVIAR_SOLUCAO o tabuleiro segue logo a seguir à
+ * mensagem como lado² bytes (um valor 0-25 por célula), e em
+ * VALIDAR_BLOCO seguem os lado valores do bloco em vez de conteudo_bloco.
+ * O tamanho é sempre o do jogo enviado em ENVIAR_JOGO.
  */
 
 #ifndef PROTOCOLO_H
 #define PROTOCOLO_H
 
+#include "tabuleiro.h"
+#include "tabuleiro_nxn.h"
+
 typedef enum
 {
     PEDIR_JOGO = 1,       // Cliente pede um jogo ao servidor
@@ -30,18 +47,30 @@ typedef enum
     RESPOSTA_SOLUCAO = 4, // Servidor responde com verificação
     VALIDAR_BLOCO = 5,    // Cliente pede validação de um bloco 3x3
     RESPOSTA_BLOCO = 6,   // Servidor responde sobre o bloco
-    JOGO_TERMINADO = 7    // Servidor informa que jogo acabou (alguém ganhou)
+    JOGO_TERMINADO = 7,   // Servidor informa que jogo acabou (alguém ganhou)
+    VALIDAR_TABULEIRO = 8, // Cliente pede validação de várias unidades num só pedido
+    RESPOSTA_TABULEIRO = 9 // Servidor responde com a máscara de unidades corretas
 } TipoMensagem;
 
+// Unidades de VALIDAR_TABULEIRO: bits 0-8 blocos, 9-17 linhas, 18-26 colunas
+#define UNIDADE_BLOCO(b) (1u << (b))
+#define UNIDADE_LINHA(r) (1u << (9 + (r)))
+#define UNIDADE_COLUNA(c) (1u << (18 + (c)))
+#define NUM_UNIDADES 27
+#define TODAS_UNIDADES ((1u << NUM_UNIDADES) - 1)
+
 typedef struct
 {
     TipoMensagem tipo;     // Tipo da mensagem (ver enum acima)
     int idCliente;         // ID do cliente que envia/recebe
     int idJogo;            // ID do jogo Sudoku
-    char tabuleiro[82];    // Tabuleiro 9x9 (81 dígitos + '\0')
+    TabuleiroCompacto tabuleiro; // Tabuleiro 9x9 (2 células por byte)
     char resposta[50];     // Resposta do servidor ("Correto", "Incorreto", etc.)
     int bloco_id;          // ID do bloco (0-8) para validação parcial
     int conteudo_bloco[9]; // Conteúdo do bloco para validação
+    int tamanhoBloco;      // 3 (ou 0) = 9x9; 4/5 = tabuleiro a seguir à mensagem
+    uint32_t unidades;     // VALIDAR_TABULEIRO: unidades a validar (UNIDADE_*)
+    uint32_t veredicto;    // RESPOSTA_TABULEIRO: unidades pedidas sem nenhum valor errado
 } MensagemSudoku;
 
 #endif
\ No newline at end of file
@@ -0,0 +1,48 @@
+/*
+ * common/include/tabuleiro.h
+ *
+ * Representação partilhada do tabuleiro Sudoku 9x9.
+ *
+ * - Tabuleiro: 81 bytes, uma célula por byte (0 = vazia, 1-9 = dígito),
+ *   por ordem de linhas. Usado pelo solver, pelo validador e pelo
+ *   carregamento de jogos no servidor.
+ * - TabuleiroCompacto: 41 bytes, duas células por byte (nibbles).
+ *   Usado para guardar e transmitir tabuleiros (protocolo).
+ */
+
+#ifndef TABULEIRO_H
+#define TABULEIRO_H
+
+#include <stdint.h>
+
+#define TAB_CELULAS 81
+#define TAB_COMPACTO_BYTES ((TAB_CELULAS + 1) / 2)
+
+typedef struct
+{
+    uint8_t celulas[TAB_CELULAS];
+} Tabuleiro;
+
+typedef struct
+{
+    uint8_t nibbles[TAB_COMPACTO_BYTES];
+} TabuleiroCompacto;
+
+// Acesso por linha/coluna
+#define TAB_CELULA(t, linha, coluna) ((t)->celulas[(linha) * 9 + (coluna)])
+
+// Converte texto ("530070000...", 81 dígitos) para tabuleiro.
+// Devolve 0 se o texto não tiver 81 dígitos 0-9.
+int tabuleiro_de_texto(Tabuleiro *t, const char *texto);
+
+// Escreve o tabuleiro como texto (81 dígitos + '\0', buffer de 82)
+void tabuleiro_para_texto(const Tabuleiro *t, char *texto);
+
+// Empacota/desempacota a forma de 41 bytes (célula par no nibble baixo)
+void tabuleiro_compactar(const Tabuleiro *t, TabuleiroCompacto *compacto);
+void tabuleiro_descompactar(const TabuleiroCompacto *compacto, Tabuleiro *t);
+
+// Número de células preenchidas
+int tabuleiro_preenchidas(const Tabuleiro *t);
+
+#endif
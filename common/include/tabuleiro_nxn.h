@@ -0,0 +1,80 @@
+/*
+ * common/include/tabuleiro_nxn.h
+ *
+ * Tabuleiros N×N com blocos de 3×3, 4×4 ou 5×5 (9×9, 16×16 e 25×25).
+ *
+ * O 9×9 clássico continua a usar Tabuleiro e os motores do cliente; este
+ * módulo serve os tamanhos maiores. O núcleo (máscaras de candidatos, MRV,
+ * propagação de singles, contagem de soluções, geração) está escrito uma
+ * vez em common/src/kernel_nxn.inc e é instanciado por tamanho de bloco em
+ * tempo de compilação, para que o lado, o número de células e a largura
+ * das máscaras sejam constantes em cada instância.
+ *
+ * Texto: uma célula por caractere, '0' ou '.' = vazia, 1-9 e depois A-P
+ * (10-25).
+ */
+
+#ifndef TABULEIRO_NXN_H
+#define TABULEIRO_NXN_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+#define NXN_MIN_BLOCO 3
+#define NXN_MAX_BLOCO 5
+#define NXN_MAX_LADO (NXN_MAX_BLOCO * NXN_MAX_BLOCO)
+#define NXN_MAX_CELULAS (NXN_MAX_LADO * NXN_MAX_LADO)
+
+// Células por ordem de linhas; só as primeiras lado² são usadas
+typedef struct
+{
+    uint8_t celulas[NXN_MAX_CELULAS];
+} TabuleiroNxN;
+
+static inline int nxn_bloco_valido(int bloco)
+{
+    return bloco >= NXN_MIN_BLOCO && bloco <= NXN_MAX_BLOCO;
+}
+
+static inline int nxn_lado(int bloco)
+{
+    return bloco * bloco;
+}
+
+static inline int nxn_celulas(int bloco)
+{
+    return bloco * bloco * bloco * bloco;
+}
+
+// Tamanho de bloco de um texto pelo número de caracteres (81, 256, 625),
+// ou 0 se não corresponder a nenhum tamanho suportado
+int nxn_bloco_de_comprimento(int comprimento);
+
+// Converte texto para tabuleiro. Devolve 0 se houver caracteres inválidos
+// ou valores acima do lado.
+int nxn_de_texto(TabuleiroNxN *t, int bloco, const char *texto);
+
+// Escreve lado² caracteres + '\0' (buffer de NXN_MAX_CELULAS + 1)
+void nxn_para_texto(const TabuleiroNxN *t, int bloco, char *texto);
+
+// Caractere de um valor (0 = '.')
+char nxn_caractere(int valor);
+
+// 1 se não houver dígitos repetidos em nenhuma linha/coluna/bloco
+// (células vazias são ignoradas)
+int nxn_validar(const TabuleiroNxN *t, int bloco);
+
+// Conta soluções até 'limite'. 'solucao' (opcional) recebe a primeira.
+// max_nos > 0 limita a pesquisa: devolve -1 se o limite for atingido antes
+// de a contagem ficar decidida. 'parar' (opcional) cancela a pesquisa
+// (também devolve -1). Pistas em conflito dão 0.
+int nxn_contar_solucoes(const TabuleiroNxN *t, int bloco, int limite, TabuleiroNxN *solucao,
+                        long max_nos, const atomic_int *parar);
+
+// Gera um puzzle de solução única: grelha completa aleatória e remoção de
+// pistas por ordem aleatória. Cada remoção é verificada com no máximo
+// 'max_nos' nós; se a verificação não ficar decidida a pista fica. Devolve 0
+// se falhar.
+int nxn_gerar(int bloco, unsigned int *semente, TabuleiroNxN *puzzle, TabuleiroNxN *solucao, long max_nos);
+
+#endif
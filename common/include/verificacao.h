@@ -0,0 +1,48 @@
+/*
+ * common/include/verificacao.h
+ *
+ * Verificação local de uma solução: regras do Sudoku (sem repetidos em
+ * linhas, colunas e blocos), tabuleiro completo e pistas por alterar. Para
+ * 9x9 com Tabuleiro; para 16x16 e 25x25 com TabuleiroNxN.
+ *
+ * Partilhada pelo servidor (verificarSolucao, verificarSolucaoNxN) e pelo
+ * cliente, que a faz antes de enviar ENVIAR_SOLUCAO: uma solução que falha
+ * aqui seria sempre recusada pelo servidor, pelo que não vale a ida e volta.
+ */
+
+#ifndef VERIFICACAO_H
+#define VERIFICACAO_H
+
+#include "tabuleiro.h"
+#include "tabuleiro_nxn.h"
+
+// Primeira regra que a solução falha (pela ordem abaixo)
+typedef enum
+{
+    VERIFICACAO_OK = 0,
+    VERIFICACAO_PISTA_ALTERADA = 1, // Uma pista do puzzle foi mudada
+    VERIFICACAO_INCOMPLETA = 2,     // Há células vazias ou acima do lado
+    VERIFICACAO_REPETIDO = 3        // Dígito repetido numa linha, coluna ou bloco
+} ResultadoVerificacaoLocal;
+
+// 1 se não houver dígitos repetidos em nenhuma linha, coluna ou bloco
+// (as células vazias não contam; um valor acima de 9 dá 0)
+int tabuleiro_sem_repetidos(const Tabuleiro *t);
+
+// 1 se todas as células tiverem um dígito 1-9
+int tabuleiro_completo(const Tabuleiro *t);
+
+// 1 se as pistas do puzzle estiverem todas na solução, com o mesmo valor
+int tabuleiro_respeita_pistas(const Tabuleiro *solucao, const Tabuleiro *puzzle);
+
+// Verificação completa: VERIFICACAO_OK se a solução resolve o puzzle
+ResultadoVerificacaoLocal verificar_solucao_local(const Tabuleiro *solucao, const Tabuleiro *puzzle);
+
+// verificar_solucao_local para qualquer tamanho de bloco (3-5); as regras
+// vêm de nxn_validar
+ResultadoVerificacaoLocal verificar_solucao_local_nxn(const TabuleiroNxN *solucao, const TabuleiroNxN *puzzle, int bloco);
+
+// Descrição curta do resultado ("pista alterada", ...)
+const char *nome_resultado_verificacao(ResultadoVerificacaoLocal resultado);
+
+#endif
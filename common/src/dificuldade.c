@@ -0,0 +1,483 @@
+// common/src/dificuldade.c - Classificação de puzzles por técnicas humanas
+
+#include <string.h>
+#include <pthread.h>
+#include "dificuldade.h"
+#include "motor_sudoku.h"
+
+// Unidades: 0-8 linhas, 9-17 colunas, 18-26 blocos (9 células cada)
+static int unidades[27][9];
+// Unidades a que cada célula pertence (linha, coluna, bloco)
+static int unidades_da_celula[81][3];
+static pthread_once_t tabelas_once = PTHREAD_ONCE_INIT;
+
+static void construir_tabelas(void)
+{
+    for (int i = 0; i < 9; i++)
+    {
+        for (int k = 0; k < 9; k++)
+        {
+            unidades[i][k] = i * 9 + k;
+            unidades[9 + i][k] = k * 9 + i;
+            unidades[18 + i][k] = ((i / 3) * 3 + k / 3) * 9 + (i % 3) * 3 + k % 3;
+        }
+    }
+    for (int pos = 0; pos < 81; pos++)
+    {
+        unidades_da_celula[pos][0] = pos / 9;
+        unidades_da_celula[pos][1] = 9 + pos % 9;
+        unidades_da_celula[pos][2] = 18 + BLOCO_DE(pos / 9, pos % 9);
+    }
+}
+
+static inline int se_veem(int a, int b)
+{
+    return a != b && (a / 9 == b / 9 || a % 9 == b % 9 ||
+                      BLOCO_DE(a / 9, a % 9) == BLOCO_DE(b / 9, b % 9));
+}
+
+// Estado da resolução lógica: valores colocados e candidatos restantes
+// (bit d-1) de cada célula vazia. Colocar retira o dígito dos vizinhos.
+typedef struct
+{
+    uint8_t valor[81];
+    uint16_t cand[81];
+    int vazias;
+} Grelha;
+
+// Resultado de cada técnica
+enum
+{
+    SEM_PROGRESSO = 0,
+    PROGRESSO = 1,
+    CONTRADICAO = -1
+};
+
+static void grelha_colocar(Grelha *g, int pos, int num)
+{
+    uint16_t bit = (uint16_t)(1u << (num - 1));
+
+    g->valor[pos] = (uint8_t)num;
+    g->cand[pos] = 0;
+    g->vazias--;
+    for (int u = 0; u < 3; u++)
+    {
+        const int *cel = unidades[unidades_da_celula[pos][u]];
+        for (int k = 0; k < 9; k++)
+            g->cand[cel[k]] &= (uint16_t)~bit;
+    }
+}
+
+static int grelha_inicializar(Grelha *g, const Tabuleiro *puzzle)
+{
+    memset(g, 0, sizeof(*g));
+    for (int pos = 0; pos < 81; pos++)
+        g->cand[pos] = TODOS_DIGITOS;
+    g->vazias = 81;
+
+    for (int pos = 0; pos < 81; pos++)
+    {
+        int num = puzzle->celulas[pos];
+        if (num == 0)
+            continue;
+        if (num > 9 || !(g->cand[pos] & (1u << (num - 1))))
+            return 0; // Pista repetida numa unidade
+        grelha_colocar(g, pos, num);
+    }
+    return 1;
+}
+
+// Posições (índices 0-8 dentro da unidade) onde o dígito ainda cabe
+static inline uint16_t posicoes_na_unidade(const Grelha *g, int u, uint16_t bit)
+{
+    uint16_t pos = 0;
+    for (int k = 0; k < 9; k++)
+        if (g->cand[unidades[u][k]] & bit)
+            pos |= (uint16_t)(1u << k);
+    return pos;
+}
+
+static inline uint16_t digitos_colocados(const Grelha *g, int u)
+{
+    uint16_t colocados = 0;
+    for (int k = 0; k < 9; k++)
+        if (g->valor[unidades[u][k]])
+            colocados |= (uint16_t)(1u << (g->valor[unidades[u][k]] - 1));
+    return colocados;
+}
+
+// Retira 'bits' dos candidatos da célula. Devolve 1 se alguma coisa mudou.
+static inline int eliminar(Grelha *g, int pos, uint16_t bits)
+{
+    if (g->valor[pos] || !(g->cand[pos] & bits))
+        return 0;
+    g->cand[pos] &= (uint16_t)~bits;
+    return 1;
+}
+
+// --- Técnicas ---
+
+static int single_oculto(Grelha *g)
+{
+    for (int u = 0; u < 27; u++)
+    {
+        uint16_t colocados = digitos_colocados(g, u);
+        for (int d = 0; d < 9; d++)
+        {
+            uint16_t bit = (uint16_t)(1u << d);
+            if (colocados & bit)
+                continue;
+            uint16_t pos = posicoes_na_unidade(g, u, bit);
+            if (pos == 0)
+                return CONTRADICAO;
+            if (__builtin_popcount(pos) == 1)
+            {
+                grelha_colocar(g, unidades[u][__builtin_ctz(pos)], d + 1);
+                return PROGRESSO;
+            }
+        }
+    }
+    return SEM_PROGRESSO;
+}
+
+static int single_nu(Grelha *g)
+{
+    for (int pos = 0; pos < 81; pos++)
+    {
+        if (g->valor[pos])
+            continue;
+        if (g->cand[pos] == 0)
+            return CONTRADICAO;
+        if (__builtin_popcount(g->cand[pos]) == 1)
+        {
+            grelha_colocar(g, pos, __builtin_ctz(g->cand[pos]) + 1);
+            return PROGRESSO;
+        }
+    }
+    return SEM_PROGRESSO;
+}
+
+// Pointing: se num bloco o dígito só cabe numa linha/coluna, sai do resto
+// dessa linha/coluna. Claiming: se numa linha/coluna só cabe dentro de um
+// bloco, sai do resto do bloco.
+static int candidatos_bloqueados(Grelha *g)
+{
+    int mudou = 0;
+
+    for (int d = 0; d < 9; d++)
+    {
+        uint16_t bit = (uint16_t)(1u << d);
+
+        for (int u = 0; u < 27; u++)
+        {
+            uint16_t pos = posicoes_na_unidade(g, u, bit);
+            if (__builtin_popcount(pos) < 2)
+                continue;
+
+            // Unidade comum a todas as células onde o dígito cabe
+            int primeira = unidades[u][__builtin_ctz(pos)];
+            for (int v = 0; v < 3; v++)
+            {
+                int alvo = unidades_da_celula[primeira][v];
+                if (alvo == u)
+                    continue;
+
+                int todas = 1;
+                for (int k = 0; k < 9 && todas; k++)
+                {
+                    if (!(pos & (1u << k)))
+                        continue;
+                    int cel = unidades[u][k];
+                    todas = unidades_da_celula[cel][v] == alvo;
+                }
+                if (!todas)
+                    continue;
+
+                for (int k = 0; k < 9; k++)
+                {
+                    int cel = unidades[alvo][k];
+                    int dentro = 0;
+                    for (int j = 0; j < 3; j++)
+                        dentro |= unidades_da_celula[cel][j] == u;
+                    if (!dentro)
+                        mudou |= eliminar(g, cel, bit);
+                }
+            }
+            if (mudou)
+                return PROGRESSO;
+        }
+    }
+    return SEM_PROGRESSO;
+}
+
+// Subconjuntos de tamanho n numa unidade:
+// - nu: n células cujos candidatos juntos são n dígitos, que saem das
+//   outras células da unidade;
+// - oculto: n dígitos que juntos só cabem em n células, que ficam só com
+//   esses dígitos.
+static int subconjuntos(Grelha *g, int n)
+{
+    for (int u = 0; u < 27; u++)
+    {
+        uint16_t vazias = 0, livres = digitos_colocados(g, u) ^ TODOS_DIGITOS;
+        for (int k = 0; k < 9; k++)
+            if (!g->valor[unidades[u][k]])
+                vazias |= (uint16_t)(1u << k);
+        if (__builtin_popcount(vazias) <= n)
+            continue;
+
+        for (uint16_t escolha = 1; escolha < 512; escolha++)
+        {
+            if (__builtin_popcount(escolha) != n)
+                continue;
+
+            // Nu: 'escolha' são células da unidade
+            if ((escolha & vazias) == escolha)
+            {
+                uint16_t uniao = 0;
+                for (int k = 0; k < 9; k++)
+                    if (escolha & (1u << k))
+                        uniao |= g->cand[unidades[u][k]];
+                if (__builtin_popcount(uniao) == n)
+                {
+                    int mudou = 0;
+                    for (int k = 0; k < 9; k++)
+                        if (!(escolha & (1u << k)))
+                            mudou |= eliminar(g, unidades[u][k], uniao);
+                    if (mudou)
+                        return PROGRESSO;
+                }
+            }
+
+            // Oculto: 'escolha' são dígitos ainda por colocar
+            if ((escolha & livres) == escolha)
+            {
+                uint16_t uniao = 0;
+                for (int d = 0; d < 9; d++)
+                    if (escolha & (1u << d))
+                        uniao |= posicoes_na_unidade(g, u, (uint16_t)(1u << d));
+                if (__builtin_popcount(uniao) < n)
+                    return CONTRADICAO;
+                if (__builtin_popcount(uniao) == n)
+                {
+                    int mudou = 0;
+                    for (int k = 0; k < 9; k++)
+                        if (uniao & (1u << k))
+                            mudou |= eliminar(g, unidades[u][k], (uint16_t)~escolha & TODOS_DIGITOS);
+                    if (mudou)
+                        return PROGRESSO;
+                }
+            }
+        }
+    }
+    return SEM_PROGRESSO;
+}
+
+// Peixe de tamanho n (2 = X-Wing, 3 = Swordfish): se em n linhas o dígito
+// só cabe em n colunas, sai dessas colunas nas outras linhas (e o mesmo
+// trocando linhas e colunas).
+static int peixe(Grelha *g, int n)
+{
+    for (int d = 0; d < 9; d++)
+    {
+        uint16_t bit = (uint16_t)(1u << d);
+
+        for (int base = 0; base <= 9; base += 9) // 0 = linhas, 9 = colunas
+        {
+            uint16_t pos[9];
+            uint16_t candidatas = 0;
+            for (int i = 0; i < 9; i++)
+            {
+                pos[i] = posicoes_na_unidade(g, base + i, bit);
+                int p = __builtin_popcount(pos[i]);
+                if (p >= 2 && p <= n)
+                    candidatas |= (uint16_t)(1u << i);
+            }
+
+            for (uint16_t escolha = 1; escolha < 512; escolha++)
+            {
+                if (__builtin_popcount(escolha) != n || (escolha & candidatas) != escolha)
+                    continue;
+
+                uint16_t cobertas = 0;
+                for (int i = 0; i < 9; i++)
+                    if (escolha & (1u << i))
+                        cobertas |= pos[i];
+                if (__builtin_popcount(cobertas) != n)
+                    continue;
+
+                // 'cobertas' são índices na unidade perpendicular
+                int mudou = 0;
+                int outra = base == 0 ? 9 : 0;
+                for (int j = 0; j < 9; j++)
+                {
+                    if (!(cobertas & (1u << j)))
+                        continue;
+                    for (int i = 0; i < 9; i++)
+                        if (!(escolha & (1u << i)))
+                            mudou |= eliminar(g, unidades[outra + j][i], bit);
+                }
+                if (mudou)
+                    return PROGRESSO;
+            }
+        }
+    }
+    return SEM_PROGRESSO;
+}
+
+// XY-Wing: pivô {x,y} que vê uma pinça {x,z} e outra {y,z}; uma das pinças
+// é z, por isso z sai das células que veem as duas.
+static int xy_wing(Grelha *g)
+{
+    for (int pivo = 0; pivo < 81; pivo++)
+    {
+        uint16_t cp = g->cand[pivo];
+        if (g->valor[pivo] || __builtin_popcount(cp) != 2)
+            continue;
+
+        for (int a = 0; a < 81; a++)
+        {
+            uint16_t ca = g->cand[a];
+            if (g->valor[a] || __builtin_popcount(ca) != 2 || ca == cp ||
+                __builtin_popcount(ca & cp) != 1 || !se_veem(pivo, a))
+                continue;
+
+            uint16_t z = ca & (uint16_t)~cp;
+            uint16_t procurado = (cp & (uint16_t)~ca) | z;
+
+            for (int b = a + 1; b < 81; b++)
+            {
+                if (g->valor[b] || g->cand[b] != procurado || !se_veem(pivo, b))
+                    continue;
+
+                int mudou = 0;
+                for (int pos = 0; pos < 81; pos++)
+                    if (pos != pivo && se_veem(pos, a) && se_veem(pos, b))
+                        mudou |= eliminar(g, pos, z);
+                if (mudou)
+                    return PROGRESSO;
+            }
+        }
+    }
+    return SEM_PROGRESSO;
+}
+
+// Aplica a técnica mais simples que faça progresso e devolve o seu nível,
+// 0 se nenhuma fizer progresso ou -1 numa contradição.
+static int passo_logico(Grelha *g)
+{
+    int r;
+
+    if ((r = single_oculto(g)) != SEM_PROGRESSO)
+        return r < 0 ? -1 : NIVEL_SINGLE_OCULTO;
+    if ((r = single_nu(g)) != SEM_PROGRESSO)
+        return r < 0 ? -1 : NIVEL_SINGLE_NU;
+    if ((r = candidatos_bloqueados(g)) != SEM_PROGRESSO)
+        return NIVEL_BLOQUEADOS;
+    if ((r = subconjuntos(g, 2)) != SEM_PROGRESSO)
+        return r < 0 ? -1 : NIVEL_PARES;
+    if ((r = subconjuntos(g, 3)) != SEM_PROGRESSO)
+        return r < 0 ? -1 : NIVEL_TRIPLOS;
+    if ((r = peixe(g, 2)) != SEM_PROGRESSO)
+        return NIVEL_X_WING;
+    if ((r = xy_wing(g)) != SEM_PROGRESSO)
+        return NIVEL_XY_WING;
+    if ((r = peixe(g, 3)) != SEM_PROGRESSO)
+        return NIVEL_SWORDFISH;
+    return 0;
+}
+
+// --- Esforço de pesquisa ---
+
+typedef struct
+{
+    Tabuleiro tabuleiro;
+    MascarasSudoku m;
+    ListaVazias vazias;
+    long nos;
+} PesquisaEsforco;
+
+static int pesquisar_esforco(PesquisaEsforco *p)
+{
+    int row, col;
+    int n = escolher_celula(&p->vazias, &p->m, HEURISTICA_MRV, &row, &col);
+
+    if (n < 0)
+        return 1;
+    if (n == 0)
+        return 0;
+
+    int pos = row * 9 + col;
+    uint16_t cand = mascaras_candidatos(&p->m, row, col);
+
+    vazias_retirar(&p->vazias, pos);
+    while (cand)
+    {
+        int num = __builtin_ctz(cand) + 1;
+        cand &= (uint16_t)(cand - 1);
+
+        p->nos++;
+        p->tabuleiro.celulas[pos] = (uint8_t)num;
+        mascaras_colocar(&p->m, row, col, num);
+        if (pesquisar_esforco(p))
+            return 1;
+        mascaras_retirar(&p->m, row, col, num);
+        p->tabuleiro.celulas[pos] = 0;
+    }
+    p->vazias.n++;
+    return 0;
+}
+
+// --- API ---
+
+int classificar_puzzle(const Tabuleiro *puzzle, Classificacao *c)
+{
+    pthread_once(&tabelas_once, construir_tabelas);
+    memset(c, 0, sizeof(*c));
+
+    PesquisaEsforco p;
+    p.tabuleiro = *puzzle;
+    p.nos = 0;
+    if (!mascaras_inicializar(&p.m, puzzle))
+        return 0;
+    vazias_inicializar(&p.vazias, puzzle);
+    if (!pesquisar_esforco(&p))
+        return 0;
+    c->nos = p.nos;
+
+    Grelha g;
+    if (!grelha_inicializar(&g, puzzle))
+        return 0;
+
+    int vazias_inicio = g.vazias;
+    NivelDificuldade nivel = NIVEL_SINGLE_OCULTO; // Puzzle já completo conta como o mais fácil
+    while (g.vazias > 0)
+    {
+        int usado = passo_logico(&g);
+        if (usado < 0)
+            return 0;
+        if (usado == 0)
+        {
+            nivel = NIVEL_TENTATIVA;
+            break;
+        }
+        c->usos[usado]++;
+        if ((NivelDificuldade)usado > nivel)
+            nivel = (NivelDificuldade)usado;
+    }
+
+    c->nivel = nivel;
+    c->preenchidas_logica = vazias_inicio - g.vazias;
+    return 1;
+}
+
+const char *nome_nivel_dificuldade(NivelDificuldade nivel)
+{
+    static const char *nomes[NUM_NIVEIS_DIFICULDADE] = {
+        "não classificado", "single oculto", "single nu", "candidatos bloqueados",
+        "pares", "triplos", "x-wing", "xy-wing", "swordfish", "tentativa"};
+
+    if ((int)nivel < 0 || nivel >= NUM_NIVEIS_DIFICULDADE)
+        return "?";
+    return nomes[nivel];
+}
@@ -0,0 +1,316 @@
+// common/src/motor_sudoku.c - Núcleo de pesquisa do Sudoku (cliente e servidor)
+//
+// Primitivas usadas pelo solver do cliente (solver.c) e pela contagem de
+// soluções, que o servidor usa para verificar a unicidade dos jogos ao
+// carregar o catálogo.
+#include <string.h>
+#include <pthread.h>
+#include "motor_sudoku.h"
+
+// Constrói as máscaras a partir do tabuleiro. Devolve 0 se as pistas já
+// estiverem em conflito (tabuleiro impossível).
+int mascaras_inicializar(MascarasSudoku *m, const Tabuleiro *tabuleiro)
+{
+    memset(m, 0, sizeof(*m));
+
+    for (int i = 0; i < 9; i++)
+    {
+        for (int j = 0; j < 9; j++)
+        {
+            int num = TAB_CELULA(tabuleiro, i, j);
+            if (num == 0)
+                continue;
+            if (num < 1 || num > 9)
+                return 0;
+
+            uint16_t bit = (uint16_t)(1u << (num - 1));
+            int b = BLOCO_DE(i, j);
+            if ((m->linhas[i] | m->colunas[j] | m->blocos[b]) & bit)
+                return 0;
+
+            m->linhas[i] |= bit;
+            m->colunas[j] |= bit;
+            m->blocos[b] |= bit;
+        }
+    }
+    return 1;
+}
+
+void vazias_inicializar(ListaVazias *v, const Tabuleiro *tabuleiro)
+{
+    v->n = 0;
+    for (int pos = 0; pos < 81; pos++)
+    {
+        if (tabuleiro->celulas[pos] != 0)
+            continue;
+        v->posicao[pos] = v->n;
+        v->celulas[v->n++] = pos;
+    }
+}
+
+// Escolhe a próxima célula onde ramificar.
+// Devolve o número de candidatos dessa célula (0 = beco sem saída)
+// ou -1 se o tabuleiro já não tiver células vazias.
+//
+// PRIMEIRA: primeira célula vazia por ordem de linhas (comportamento original).
+// MRV: célula com menos candidatos; em caso de empate ganha a que tem mais
+// vizinhos vazios na linha/coluna/bloco (mais restritiva para o resto).
+int escolher_celula(const ListaVazias *v, const MascarasSudoku *m, HeuristicaCelula heuristica, int *row, int *col)
+{
+    int melhor = -1;
+    int melhor_grau = -1;
+    int melhor_pos = 81;
+
+    for (int k = 0; k < v->n; k++)
+    {
+        int pos = v->celulas[k];
+        int i = pos / 9, j = pos % 9;
+        int n = __builtin_popcount(mascaras_candidatos(m, i, j));
+
+        if (n <= 1 && heuristica != HEURISTICA_PRIMEIRA)
+        {
+            // Célula forçada ou sem saída: não vale a pena procurar mais
+            *row = i;
+            *col = j;
+            return n;
+        }
+
+        if (heuristica == HEURISTICA_PRIMEIRA)
+        {
+            // A lista não está por ordem: guardar a de menor índice
+            if (pos < melhor_pos)
+            {
+                melhor_pos = pos;
+                melhor = n;
+                *row = i;
+                *col = j;
+            }
+            continue;
+        }
+
+        if (melhor != -1 && n > melhor)
+            continue;
+
+        int grau = 27 - __builtin_popcount(m->linhas[i]) - __builtin_popcount(m->colunas[j]) - __builtin_popcount(m->blocos[BLOCO_DE(i, j)]);
+
+        if (melhor == -1 || n < melhor || grau > melhor_grau)
+        {
+            melhor = n;
+            melhor_grau = grau;
+            *row = i;
+            *col = j;
+        }
+    }
+
+    return melhor;
+}
+
+// Células (índice linha*9+coluna) de cada unidade: 9 linhas, 9 colunas, 9 blocos
+static int unidades[27][9];
+static pthread_once_t unidades_once = PTHREAD_ONCE_INIT;
+
+static void inicializar_unidades(void)
+{
+    for (int u = 0; u < 9; u++)
+    {
+        for (int k = 0; k < 9; k++)
+        {
+            unidades[u][k] = u * 9 + k;                                         // Linha u
+            unidades[9 + u][k] = k * 9 + u;                                     // Coluna u
+            unidades[18 + u][k] = ((u / 3) * 3 + k / 3) * 9 + (u % 3) * 3 + k % 3; // Bloco u
+        }
+    }
+}
+
+// Desfaz as colocações registadas no trilho a partir da posição 'inicio'
+void desfazer_trilho(Tabuleiro *tabuleiro, MascarasSudoku *m, const int *trilho, int *n_trilho, int inicio)
+{
+    while (*n_trilho > inicio)
+    {
+        int pos = trilho[--(*n_trilho)];
+        int row = pos / 9, col = pos % 9;
+        mascaras_retirar(m, row, col, TAB_CELULA(tabuleiro, row, col));
+        TAB_CELULA(tabuleiro, row, col) = 0;
+    }
+}
+
+// Preenche células forçadas até não haver mais deduções:
+// - naked single: célula com um único candidato
+// - hidden single: dígito que só cabe numa célula da linha/coluna/bloco
+// Cada colocação fica registada no trilho para poder ser desfeita.
+// Devolve 0 se encontrar uma contradição (célula ou dígito sem lugar).
+int propagar(Tabuleiro *tabuleiro, MascarasSudoku *m, int *trilho, int *n_trilho)
+{
+    uint8_t *celulas = tabuleiro->celulas;
+    int alterou = 1;
+
+    while (alterou)
+    {
+        alterou = 0;
+
+        // Naked singles
+        for (int pos = 0; pos < 81; pos++)
+        {
+            if (celulas[pos] != 0)
+                continue;
+
+            int row = pos / 9, col = pos % 9;
+            uint16_t cand = mascaras_candidatos(m, row, col);
+            if (cand == 0)
+                return 0;
+            if (cand & (cand - 1))
+                continue;
+
+            int num = __builtin_ctz(cand) + 1;
+            celulas[pos] = (uint8_t)num;
+            mascaras_colocar(m, row, col, num);
+            trilho[(*n_trilho)++] = pos;
+            alterou = 1;
+        }
+
+        // Hidden singles por unidade
+        for (int u = 0; u < 27; u++)
+        {
+            uint16_t colocados = 0, uma_vez = 0, varias_vezes = 0;
+
+            for (int k = 0; k < 9; k++)
+            {
+                int pos = unidades[u][k];
+                if (celulas[pos] != 0)
+                {
+                    colocados |= (uint16_t)(1u << (celulas[pos] - 1));
+                    continue;
+                }
+                uint16_t cand = mascaras_candidatos(m, pos / 9, pos % 9);
+                varias_vezes |= uma_vez & cand;
+                uma_vez |= cand;
+            }
+
+            // Dígito que falta na unidade e não cabe em nenhuma célula
+            if ((colocados | uma_vez) != TODOS_DIGITOS)
+                return 0;
+
+            uint16_t unicos = uma_vez & ~varias_vezes;
+            while (unicos)
+            {
+                uint16_t bit = unicos & (uint16_t)-unicos;
+                unicos &= unicos - 1;
+
+                for (int k = 0; k < 9; k++)
+                {
+                    int pos = unidades[u][k];
+                    if (celulas[pos] != 0)
+                        continue;
+
+                    int row = pos / 9, col = pos % 9;
+                    if (!(mascaras_candidatos(m, row, col) & bit))
+                        continue;
+
+                    int num = __builtin_ctz(bit) + 1;
+                    celulas[pos] = (uint8_t)num;
+                    mascaras_colocar(m, row, col, num);
+                    trilho[(*n_trilho)++] = pos;
+                    alterou = 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    return 1;
+}
+
+void motor_sudoku_inicializar(void)
+{
+    pthread_once(&unidades_once, inicializar_unidades);
+}
+
+// Ponto de decisão da contagem (pilha explícita, como no solver)
+typedef struct
+{
+    int pos;
+    uint16_t candidatos; // Candidatos ainda por tentar
+    int inicio_trilho;   // Tamanho do trilho antes de qualquer tentativa
+} DecisaoContagem;
+
+// Pesquisa completa com MRV e propagação: em vez de parar na primeira
+// solução, conta-a e recua como num beco sem saída, até esgotar a árvore
+// ou chegar ao limite
+int contar_solucoes(const Tabuleiro *tabuleiro, int limite, Tabuleiro *solucao)
+{
+    motor_sudoku_inicializar();
+    if (limite < 1)
+        limite = 1;
+
+    Tabuleiro t = *tabuleiro;
+    MascarasSudoku m;
+    if (!mascaras_inicializar(&m, &t))
+        return 0;
+
+    // Deduções da raiz: comuns a todas as soluções, nunca são desfeitas
+    int trilho[81];
+    int n_trilho = 0;
+    if (!propagar(&t, &m, trilho, &n_trilho))
+        return 0;
+
+    ListaVazias vazias;
+    vazias_inicializar(&vazias, &t);
+
+    DecisaoContagem pilha[81];
+    int topo = 0;
+    int contagem = 0;
+
+    for (;;)
+    {
+        int row = -1, col = -1;
+        int n = escolher_celula(&vazias, &m, HEURISTICA_MRV, &row, &col);
+
+        if (n < 0)
+        {
+            // Tabuleiro completo: mais uma solução
+            if (contagem++ == 0 && solucao)
+                *solucao = t;
+            if (contagem >= limite)
+                return contagem;
+        }
+        else if (n > 0)
+        {
+            DecisaoContagem *d = &pilha[topo++];
+            d->pos = row * 9 + col;
+            d->candidatos = mascaras_candidatos(&m, row, col);
+            d->inicio_trilho = n_trilho;
+        }
+
+        // Tentar o próximo candidato do topo; recuar quando se esgotam
+        for (;;)
+        {
+            if (topo == 0)
+                return contagem;
+
+            DecisaoContagem *d = &pilha[topo - 1];
+            vazias.n += n_trilho - d->inicio_trilho;
+            desfazer_trilho(&t, &m, trilho, &n_trilho, d->inicio_trilho);
+
+            if (!d->candidatos)
+            {
+                topo--;
+                continue;
+            }
+
+            int num = __builtin_ctz(d->candidatos) + 1;
+            d->candidatos &= d->candidatos - 1;
+
+            t.celulas[d->pos] = (uint8_t)num;
+            mascaras_colocar(&m, d->pos / 9, d->pos % 9, num);
+            trilho[n_trilho++] = d->pos;
+
+            int consistente = propagar(&t, &m, trilho, &n_trilho);
+
+            for (int k = d->inicio_trilho; k < n_trilho; k++)
+                vazias_retirar(&vazias, trilho[k]);
+
+            if (consistente)
+                break;
+        }
+    }
+}
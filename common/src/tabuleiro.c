@@ -0,0 +1,48 @@
+// common/src/tabuleiro.c - Conversões do tabuleiro partilhado
+
+#include "tabuleiro.h"
+
+int tabuleiro_de_texto(Tabuleiro *t, const char *texto)
+{
+    for (int i = 0; i < TAB_CELULAS; i++)
+    {
+        if (texto[i] < '0' || texto[i] > '9')
+            return 0;
+        t->celulas[i] = (uint8_t)(texto[i] - '0');
+    }
+    return 1;
+}
+
+void tabuleiro_para_texto(const Tabuleiro *t, char *texto)
+{
+    for (int i = 0; i < TAB_CELULAS; i++)
+        texto[i] = (char)('0' + t->celulas[i]);
+    texto[TAB_CELULAS] = '\0';
+}
+
+void tabuleiro_compactar(const Tabuleiro *t, TabuleiroCompacto *compacto)
+{
+    for (int i = 0; i < TAB_CELULAS / 2; i++)
+        compacto->nibbles[i] = (uint8_t)(t->celulas[2 * i] | (t->celulas[2 * i + 1] << 4));
+
+    // 81 é ímpar: o último byte só tem uma célula
+    compacto->nibbles[TAB_COMPACTO_BYTES - 1] = t->celulas[TAB_CELULAS - 1];
+}
+
+void tabuleiro_descompactar(const TabuleiroCompacto *compacto, Tabuleiro *t)
+{
+    for (int i = 0; i < TAB_CELULAS / 2; i++)
+    {
+        t->celulas[2 * i] = compacto->nibbles[i] & 0x0F;
+        t->celulas[2 * i + 1] = compacto->nibbles[i] >> 4;
+    }
+    t->celulas[TAB_CELULAS - 1] = compacto->nibbles[TAB_COMPACTO_BYTES - 1] & 0x0F;
+}
+
+int tabuleiro_preenchidas(const Tabuleiro *t)
+{
+    int n = 0;
+    for (int i = 0; i < TAB_CELULAS; i++)
+        n += t->celulas[i] != 0;
+    return n;
+}
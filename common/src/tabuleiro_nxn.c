@@ -0,0 +1,116 @@
+// common/src/tabuleiro_nxn.c - Tabuleiros N×N (instâncias do núcleo por tamanho)
+
+#include <stdlib.h>
+#include <string.h>
+#include "tabuleiro_nxn.h"
+
+#define BLOCO 3
+#include "kernel_nxn.inc"
+#undef BLOCO
+
+#define BLOCO 4
+#include "kernel_nxn.inc"
+#undef BLOCO
+
+#define BLOCO 5
+#include "kernel_nxn.inc"
+#undef BLOCO
+
+int nxn_bloco_de_comprimento(int comprimento)
+{
+    for (int bloco = NXN_MIN_BLOCO; bloco <= NXN_MAX_BLOCO; bloco++)
+        if (nxn_celulas(bloco) == comprimento)
+            return bloco;
+    return 0;
+}
+
+char nxn_caractere(int valor)
+{
+    if (valor == 0)
+        return '.';
+    return valor <= 9 ? (char)('0' + valor) : (char)('A' + valor - 10);
+}
+
+int nxn_de_texto(TabuleiroNxN *t, int bloco, const char *texto)
+{
+    int lado = nxn_lado(bloco);
+
+    for (int i = 0; i < nxn_celulas(bloco); i++)
+    {
+        char ch = texto[i];
+        int valor;
+
+        if (ch == '0' || ch == '.')
+            valor = 0;
+        else if (ch >= '1' && ch <= '9')
+            valor = ch - '0';
+        else if (ch >= 'A' && ch <= 'Z')
+            valor = ch - 'A' + 10;
+        else if (ch >= 'a' && ch <= 'z')
+            valor = ch - 'a' + 10;
+        else
+            return 0;
+
+        if (valor > lado)
+            return 0;
+        t->celulas[i] = (uint8_t)valor;
+    }
+    return 1;
+}
+
+void nxn_para_texto(const TabuleiroNxN *t, int bloco, char *texto)
+{
+    int n = nxn_celulas(bloco);
+
+    for (int i = 0; i < n; i++)
+        texto[i] = t->celulas[i] ? nxn_caractere(t->celulas[i]) : '0';
+    texto[n] = '\0';
+}
+
+int nxn_validar(const TabuleiroNxN *t, int bloco)
+{
+    switch (bloco)
+    {
+    case 3:
+        return validar_3(t->celulas);
+    case 4:
+        return validar_4(t->celulas);
+    case 5:
+        return validar_5(t->celulas);
+    }
+    return 0;
+}
+
+int nxn_contar_solucoes(const TabuleiroNxN *t, int bloco, int limite, TabuleiroNxN *solucao,
+                        long max_nos, const atomic_int *parar)
+{
+    uint8_t *destino = solucao ? solucao->celulas : NULL;
+
+    switch (bloco)
+    {
+    case 3:
+        return contar_3(t->celulas, limite, destino, max_nos, parar, NULL);
+    case 4:
+        return contar_4(t->celulas, limite, destino, max_nos, parar, NULL);
+    case 5:
+        return contar_5(t->celulas, limite, destino, max_nos, parar, NULL);
+    }
+    return 0;
+}
+
+int nxn_gerar(int bloco, unsigned int *semente, TabuleiroNxN *puzzle, TabuleiroNxN *solucao, long max_nos)
+{
+    memset(puzzle, 0, sizeof(*puzzle));
+    memset(solucao, 0, sizeof(*solucao));
+
+    switch (bloco)
+    {
+    case 3:
+        return gerar_3(semente, puzzle->celulas, solucao->celulas, max_nos);
+    case 4:
+        return gerar_4(semente, puzzle->celulas, solucao->celulas, max_nos);
+    case 5:
+        return gerar_5(semente, puzzle->celulas, solucao->celulas, max_nos);
+    }
+    return 0;
+}
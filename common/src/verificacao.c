@@ -0,0 +1,95 @@
+// common/src/verificacao.c - Verificação local de soluções (9x9 e N×N)
+
+#include "verificacao.h"
+#include "motor_sudoku.h"
+
+int tabuleiro_sem_repetidos(const Tabuleiro *t)
+{
+    // Bit (d - 1) ligado se o dígito d já apareceu na unidade
+    uint16_t linhas[9] = {0}, colunas[9] = {0}, blocos[9] = {0};
+
+    for (int i = 0; i < TAB_CELULAS; i++)
+    {
+        int val = t->celulas[i];
+        if (val == 0)
+            continue;
+        if (val > 9)
+            return 0;
+
+        int row = i / 9, col = i % 9, bloco = BLOCO_DE(row, col);
+        uint16_t bit = (uint16_t)(1u << (val - 1));
+        if ((linhas[row] | colunas[col] | blocos[bloco]) & bit)
+            return 0;
+        linhas[row] |= bit;
+        colunas[col] |= bit;
+        blocos[bloco] |= bit;
+    }
+    return 1;
+}
+
+int tabuleiro_completo(const Tabuleiro *t)
+{
+    for (int i = 0; i < TAB_CELULAS; i++)
+    {
+        if (t->celulas[i] < 1 || t->celulas[i] > 9)
+            return 0;
+    }
+    return 1;
+}
+
+int tabuleiro_respeita_pistas(const Tabuleiro *solucao, const Tabuleiro *puzzle)
+{
+    for (int i = 0; i < TAB_CELULAS; i++)
+    {
+        if (puzzle->celulas[i] != 0 && solucao->celulas[i] != puzzle->celulas[i])
+            return 0;
+    }
+    return 1;
+}
+
+ResultadoVerificacaoLocal verificar_solucao_local(const Tabuleiro *solucao, const Tabuleiro *puzzle)
+{
+    if (!tabuleiro_respeita_pistas(solucao, puzzle))
+        return VERIFICACAO_PISTA_ALTERADA;
+    if (!tabuleiro_completo(solucao))
+        return VERIFICACAO_INCOMPLETA;
+    if (!tabuleiro_sem_repetidos(solucao))
+        return VERIFICACAO_REPETIDO;
+    return VERIFICACAO_OK;
+}
+
+ResultadoVerificacaoLocal verificar_solucao_local_nxn(const TabuleiroNxN *solucao, const TabuleiroNxN *puzzle, int bloco)
+{
+    int lado = nxn_lado(bloco);
+    int celulas = nxn_celulas(bloco);
+
+    for (int i = 0; i < celulas; i++)
+    {
+        if (puzzle->celulas[i] != 0 && solucao->celulas[i] != puzzle->celulas[i])
+            return VERIFICACAO_PISTA_ALTERADA;
+    }
+    for (int i = 0; i < celulas; i++)
+    {
+        if (solucao->celulas[i] < 1 || solucao->celulas[i] > lado)
+            return VERIFICACAO_INCOMPLETA;
+    }
+    if (!nxn_validar(solucao, bloco))
+        return VERIFICACAO_REPETIDO;
+    return VERIFICACAO_OK;
+}
+
+const char *nome_resultado_verificacao(ResultadoVerificacaoLocal resultado)
+{
+    switch (resultado)
+    {
+    case VERIFICACAO_OK:
+        return "válida";
+    case VERIFICACAO_PISTA_ALTERADA:
+        return "pista alterada";
+    case VERIFICACAO_INCOMPLETA:
+        return "tabuleiro incompleto";
+    case VERIFICACAO_REPETIDO:
+        return "dígito repetido";
+    }
+    return "?";
+}
@@ -1,5 +1,7 @@
 #ifndef CONFIG_SERVIDOR_H
 #define CONFIG_SERVIDOR_H
+#include "tabuleiro.h"
+#include "tabuleiro_nxn.h"
 #define MAX_JOGOS 100
 
 typedef enum {
@@ -7,6 +9,13 @@ typedef enum {
     MODO_DEBUG    // Desenvolvimento - apaga logs ao encerrar
 } ModoOperacao;
 
+// Verificação de solução única ao carregar o catálogo de jogos
+typedef enum {
+    UNICIDADE_DESLIGADA, // Aceitar qualquer jogo bem formado
+    UNICIDADE_AVISAR,    // Verificar e avisar, mas carregar na mesma
+    UNICIDADE_REJEITAR   // Rejeitar jogos sem solução única ou com solução guardada errada
+} ModoUnicidade;
+
 typedef struct {
     char ficheiroJogos[100];
     char ficheiroSolucoes[100];
@@ -22,16 +31,27 @@ typedef struct {
     ModoOperacao modo;          // PADRAO ou DEBUG
     int diasRetencaoLogs;       // Dias para manter logs (modo PADRAO)
     int limparLogsEncerramento; // Apagar logs ao encerrar (modo DEBUG)
+    ModoUnicidade unicidade;    // Verificação de solução única ao carregar (opcional)
+    int dificuldadeMin;         // Nível mínimo dos jogos a usar (opcional, 0 = inclui não classificados)
+    int dificuldadeMax;         // Nível máximo dos jogos a usar (opcional)
+    int geradores;              // Threads a gerar jogos novos em segundo plano (opcional, 0 = desligado)
+    int poolGerados;            // Jogos gerados mantidos prontos (opcional)
+    int tamanhoBloco;           // 3 = 9x9, 4 = 16x16, 5 = 25x25 (opcional)
 } ConfigServidor;
 
 int lerConfigServidor(const char *nomeFicheiro, ConfigServidor *config);
 
 typedef struct {
     int idjogo;
-    char tabuleiro [82];
-    char solucao[82];
+    int tamanhoBloco;           // 3: tabuleiro/solucao; 4 ou 5: tabuleiroNxN/solucaoNxN
+    Tabuleiro tabuleiro;        // 0 = célula vazia
+    Tabuleiro solucao;
+    TabuleiroNxN tabuleiroNxN;  // Só para 16x16 e 25x25
+    TabuleiroNxN solucaoNxN;
+    int dificuldade;            // Nível de sudoku-rater (NivelDificuldade), 0 = não classificado
+    long esforco;               // Nós de pesquisa medidos por sudoku-rater
 } Jogo;
 
-int carregarJogos(const char *ficheiro, Jogo jogos[], int maxJogos);
+int carregarJogos(const char *ficheiro, Jogo jogos[], int maxJogos, ModoUnicidade unicidade);
 
 #endif
@@ -0,0 +1,25 @@
+#ifndef GERADOR_H
+#define GERADOR_H
+
+#include "servidor.h"
+
+// Gera um puzzle de solução única: grelha completa aleatória seguida de
+// remoção de pistas por ordem aleatória, mantendo só as remoções que não
+// criam uma segunda solução. Classifica-o com o sudoku-rater (dificuldade
+// e esforço). Com bloco 4 ou 5 gera um 16x16 ou 25x25 (sem classificação).
+// O idjogo fica a 0. Devolve 0 se falhar.
+int gerarJogo(unsigned int *semente, int bloco, Jogo *jogo);
+
+// Lança 'numThreads' threads no processo pai que mantêm o pool de jogos
+// prontos da memória partilhada cheio, com jogos do tamanho de bloco
+// pedido e (9x9) de dificuldade entre 'minimo' e 'maximo'. Devolve o
+// número de threads criadas.
+int iniciarGeradores(DadosPartilhados *dados, int numThreads, int bloco, int minimo, int maximo);
+
+// Escolhe o jogo da próxima ronda para dados->jogoCorrente: o mais antigo
+// do pool de gerados ou, com o pool vazio, um jogo aleatório do catálogo.
+// Chamar com dados->mutex adquirido. Não gera nada (é só uma cópia), para
+// que o arranque do lobby nunca espere pelo gerador.
+void escolherProximoJogo(DadosPartilhados *dados, Jogo jogos[], int numJogos);
+
+#endif
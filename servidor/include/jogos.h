@@ -10,22 +10,29 @@ typedef struct {
     int numerosCertos;     // Quantidade de números certos
 } ResultadoVerificacao;
 
-// Carrega jogos do ficheiro
-int carregarJogos(const char *ficheiro, Jogo jogos[], int maxJogos);
+// Carrega jogos do ficheiro e verifica a unicidade da solução conforme 'unicidade'
+int carregarJogos(const char *ficheiro, Jogo jogos[], int maxJogos, ModoUnicidade unicidade);
+
+// Mantém só os jogos com dificuldade entre 'minimo' e 'maximo' (inclusive).
+// Devolve o número de jogos que ficam.
+int filtrarPorDificuldade(Jogo jogos[], int numJogos, int minimo, int maximo);
 
 // Verifica se uma solução está correta (valida regras e compara com puzzle original)
-ResultadoVerificacao verificarSolucao(const char *solucao, const char *solucaoCorreta, const char *puzzleOriginal);
+ResultadoVerificacao verificarSolucao(const Tabuleiro *solucao, const Tabuleiro *solucaoCorreta, const Tabuleiro *puzzleOriginal);
 
-// Verifica se um tabuleiro é válido (sem números repetidos em linha/coluna/região)
-int validarTabuleiro(const char *tabuleiro);
+// Validação parcial (VALIDAR_TABULEIRO): das unidades pedidas (máscara
+// UNIDADE_* do protocolo), devolve as que não têm nenhum valor preenchido
+// diferente da solução
+uint32_t validarUnidades(const Tabuleiro *parcial, const Tabuleiro *solucaoCorreta, uint32_t unidades);
 
-// Imprime um tabuleiro de forma visual
-void imprimirTabuleiro(const char *tabuleiro);
+// verificarSolucao para 16x16 e 25x25
+ResultadoVerificacao verificarSolucaoNxN(const TabuleiroNxN *solucao, const TabuleiroNxN *solucaoCorreta,
+                                         const TabuleiroNxN *puzzleOriginal, int bloco);
 
-// Converte string de tabuleiro para matriz 9x9
-void stringParaMatriz(const char *str, int matriz[9][9]);
+// Mantém só os jogos com o tamanho de bloco pedido. Devolve quantos ficam.
+int filtrarPorTamanho(Jogo jogos[], int numJogos, int bloco);
 
-// Converte matriz 9x9 para string
-void matrizParaString(int matriz[9][9], char *str);
+// Imprime um tabuleiro de forma visual
+void imprimirTabuleiro(const Tabuleiro *tabuleiro);
 
 #endif
\ No newline at end of file
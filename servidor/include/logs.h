@@ -22,6 +22,7 @@ typedef enum {
     EVT_VALIDACAO_BLOCO_OK = 17,
     EVT_VALIDACAO_BLOCO_NOK = 18,
     EVT_JOGO_PERDIDO = 19,
+    EVT_VALIDACAO_TABULEIRO = 20,
     EVT_ERRO_GERAL = 99
 } CodigoEvento;
 
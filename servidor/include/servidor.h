@@ -5,19 +5,33 @@
 #include <time.h>
 #include "config_servidor.h" // <-- Importante: Isto define a struct Jogo
 
+#define MAX_JOGOS_PRONTOS 32             // Capacidade máxima do pool de jogos gerados
+#define ID_PRIMEIRO_JOGO_GERADO 100000   // IDs dos jogos gerados (não colidem com o catálogo)
+
 // Estrutura para Memória Partilhada (Lobby Dinâmico)
 typedef struct {
     int numClientesJogando;     // Total de clientes atualmente jogando (máx: MAX_CLIENTES_JOGO)
     int numClientesLobby;       // Clientes aguardando no lobby
     int numJogadoresAtivos;     // Clientes que estão atualmente a resolver o puzzle
     time_t ultimaEntrada;       // Timestamp da última conexão (para timer de agregação)
-    int jogoAtual;              // ID do jogo atual sendo jogado (índice no array de jogos)
+    int jogoAtual;              // ID do jogo atual sendo jogado (idjogo de jogoCorrente)
+    Jogo jogoCorrente;          // Cópia do jogo da ronda (do catálogo ou do gerador)
     int jogoIniciado;           // Flag: 1 = jogo em curso, 0 = aguardando jogadores
     int jogoTerminado;          // Flag: 1 = alguém já ganhou este jogo
     int idVencedor;             // PID do cliente vencedor
     time_t tempoVitoria;        // Timestamp da vitória
     sem_t mutex;                // Proteção para acesso à memória partilhada
     sem_t lobby_semaforo;       // Semáforo para despertar clientes quando jogo inicia
+
+    // Pool de jogos gerados em segundo plano (fila circular, protegida por mutex)
+    Jogo prontos[MAX_JOGOS_PRONTOS];
+    int inicioProntos;          // Índice do jogo pronto mais antigo
+    int numProntos;             // Jogos prontos a servir
+    int capacidadeProntos;      // Tamanho do pool (POOL_GERADOS)
+    int proximoIdGerado;        // ID a dar ao próximo jogo gerado
+    long jogosGerados;          // Total de jogos gerados desde o arranque
+    long jogosDoCatalogo;       // Rondas servidas do catálogo por o pool estar vazio
+    sem_t vagasProntos;         // Lugares livres no pool (os geradores esperam aqui)
 } DadosPartilhados;
 
 // Protótipo da função que está em util-stream-server.c
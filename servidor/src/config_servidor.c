@@ -5,6 +5,7 @@
 #include <string.h>
 #include <ctype.h>
 #include "config_servidor.h"
+#include "dificuldade.h"
 
 static void trim(char *str)
 {
@@ -40,6 +41,12 @@ int lerConfigServidor(const char *nomeFicheiro, ConfigServidor *config)
     config->modo = -1;
     config->diasRetencaoLogs = -1;
     config->limparLogsEncerramento = -1;
+    config->unicidade = UNICIDADE_AVISAR; // Opcional: verificar e avisar por omissão
+    config->dificuldadeMin = 0;           // Opcional: por omissão aceita todos os níveis
+    config->dificuldadeMax = NIVEL_TENTATIVA;
+    config->geradores = 1;                // Opcional: uma thread a gerar jogos novos
+    config->poolGerados = 8;
+    config->tamanhoBloco = 3;             // Opcional: 9x9 clássico
 
     char linha[200];
     while (fgets(linha, sizeof(linha), f))
@@ -143,6 +150,50 @@ int lerConfigServidor(const char *nomeFicheiro, ConfigServidor *config)
             {
                 config->limparLogsEncerramento = atoi(valor);
             }
+            else if (strcmp(parametro, "UNICIDADE") == 0)
+            {
+                if (strcmp(valor, "DESLIGADA") == 0)
+                {
+                    config->unicidade = UNICIDADE_DESLIGADA;
+                }
+                else if (strcmp(valor, "AVISAR") == 0)
+                {
+                    config->unicidade = UNICIDADE_AVISAR;
+                }
+                else if (strcmp(valor, "REJEITAR") == 0)
+                {
+                    config->unicidade = UNICIDADE_REJEITAR;
+                }
+                else
+                {
+                    printf("Aviso: UNICIDADE desconhecida '%s' (use DESLIGADA, AVISAR ou REJEITAR), a usar AVISAR\n", valor);
+                }
+            }
+            else if (strcmp(parametro, "DIFICULDADE_MIN") == 0)
+            {
+                config->dificuldadeMin = atoi(valor);
+            }
+            else if (strcmp(parametro, "DIFICULDADE_MAX") == 0)
+            {
+                config->dificuldadeMax = atoi(valor);
+            }
+            else if (strcmp(parametro, "GERADORES") == 0)
+            {
+                config->geradores = atoi(valor);
+            }
+            else if (strcmp(parametro, "POOL_GERADOS") == 0)
+            {
+                config->poolGerados = atoi(valor);
+            }
+            else if (strcmp(parametro, "TAMANHO_BLOCO") == 0)
+            {
+                config->tamanhoBloco = atoi(valor);
+                if (!nxn_bloco_valido(config->tamanhoBloco))
+                {
+                    printf("Aviso: TAMANHO_BLOCO inválido '%s' (use 3, 4 ou 5), a usar 3\n", valor);
+                    config->tamanhoBloco = 3;
+                }
+            }
         }
     }
 
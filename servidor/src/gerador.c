@@ -0,0 +1,201 @@
+// servidor/src/gerador.c - Geração de jogos em segundo plano
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "gerador.h"
+#include "motor_sudoku.h"
+#include "dificuldade.h"
+#include "logs.h"
+
+// Tentativas de gerar um jogo dentro do intervalo de dificuldade antes de
+// aceitar um fora dele (intervalos muito estreitos podem ser raros)
+#define TENTATIVAS_DIFICULDADE 50
+
+// Nós por verificação de unicidade ao retirar pistas em 16x16 e 25x25.
+// Uma verificação que não fica decidida mantém a pista: o jogo continua
+// de solução única, só fica com mais pistas. Com 100 nós um 25x25 gera-se
+// em cerca de 1s com o mesmo número de pistas que com 2000 (15s).
+#define NOS_VERIFICACAO_NXN 100
+
+typedef struct
+{
+    DadosPartilhados *dados;
+    int bloco;
+    int minimo;
+    int maximo;
+    unsigned int semente;
+} ArgsGerador;
+
+// Preenche o tabuleiro com uma solução aleatória (backtracking MRV com os
+// candidatos por ordem aleatória)
+static int preencherAleatorio(Tabuleiro *t, MascarasSudoku *m, ListaVazias *v, unsigned int *semente)
+{
+    int row, col;
+    int n = escolher_celula(v, m, HEURISTICA_MRV, &row, &col);
+
+    if (n < 0)
+        return 1;
+    if (n == 0)
+        return 0;
+
+    int pos = row * 9 + col;
+    uint16_t cand = mascaras_candidatos(m, row, col);
+
+    vazias_retirar(v, pos);
+    while (cand)
+    {
+        // Escolher um dos candidatos restantes ao acaso
+        int k = rand_r(semente) % __builtin_popcount(cand);
+        uint16_t resto = cand;
+        while (k-- > 0)
+            resto &= (uint16_t)(resto - 1);
+        int num = __builtin_ctz(resto) + 1;
+        cand &= (uint16_t)~(1u << (num - 1));
+
+        t->celulas[pos] = (uint8_t)num;
+        mascaras_colocar(m, row, col, num);
+        if (preencherAleatorio(t, m, v, semente))
+            return 1;
+        mascaras_retirar(m, row, col, num);
+        t->celulas[pos] = 0;
+    }
+    v->n++;
+    return 0;
+}
+
+int gerarJogo(unsigned int *semente, int bloco, Jogo *jogo)
+{
+    if (bloco != 3)
+    {
+        // 16x16 e 25x25: núcleo N×N, sem classificação de dificuldade
+        memset(jogo, 0, sizeof(*jogo));
+        jogo->tamanhoBloco = bloco;
+        return nxn_gerar(bloco, semente, &jogo->tabuleiroNxN, &jogo->solucaoNxN, NOS_VERIFICACAO_NXN);
+    }
+
+    Tabuleiro solucao;
+    MascarasSudoku m;
+    ListaVazias v;
+
+    memset(&solucao, 0, sizeof(solucao));
+    mascaras_inicializar(&m, &solucao);
+    vazias_inicializar(&v, &solucao);
+    if (!preencherAleatorio(&solucao, &m, &v, semente))
+        return 0;
+
+    // Retirar pistas por ordem aleatória enquanto a solução continuar única
+    int ordem[TAB_CELULAS];
+    for (int i = 0; i < TAB_CELULAS; i++)
+        ordem[i] = i;
+    for (int i = TAB_CELULAS - 1; i > 0; i--)
+    {
+        int j = rand_r(semente) % (i + 1);
+        int tmp = ordem[i];
+        ordem[i] = ordem[j];
+        ordem[j] = tmp;
+    }
+
+    Tabuleiro puzzle = solucao;
+    for (int i = 0; i < TAB_CELULAS; i++)
+    {
+        int pos = ordem[i];
+        uint8_t valor = puzzle.celulas[pos];
+
+        puzzle.celulas[pos] = 0;
+        if (contar_solucoes(&puzzle, 2, NULL) != 1)
+            puzzle.celulas[pos] = valor;
+    }
+
+    Classificacao c;
+    if (!classificar_puzzle(&puzzle, &c))
+        return 0;
+
+    jogo->idjogo = 0;
+    jogo->tamanhoBloco = 3;
+    jogo->tabuleiro = puzzle;
+    jogo->solucao = solucao;
+    jogo->dificuldade = c.nivel;
+    jogo->esforco = c.nos;
+    return 1;
+}
+
+static void *threadGerador(void *arg)
+{
+    ArgsGerador *a = (ArgsGerador *)arg;
+    DadosPartilhados *dados = a->dados;
+
+    for (;;)
+    {
+        // Gerar fora de qualquer lock; só a cópia para o pool é protegida
+        Jogo novo;
+        int tentativas = 0;
+        while (!gerarJogo(&a->semente, a->bloco, &novo) ||
+               (a->bloco == 3 && (novo.dificuldade < a->minimo || novo.dificuldade > a->maximo) &&
+                ++tentativas < TENTATIVAS_DIFICULDADE))
+            ;
+
+        // Esperar por uma vaga no pool (bloqueia enquanto estiver cheio)
+        sem_wait(&dados->vagasProntos);
+
+        sem_wait(&dados->mutex);
+        novo.idjogo = dados->proximoIdGerado++;
+        int fim = (dados->inicioProntos + dados->numProntos) % dados->capacidadeProntos;
+        dados->prontos[fim] = novo;
+        dados->numProntos++;
+        dados->jogosGerados++;
+        sem_post(&dados->mutex);
+    }
+
+    return NULL;
+}
+
+int iniciarGeradores(DadosPartilhados *dados, int numThreads, int bloco, int minimo, int maximo)
+{
+    int criadas = 0;
+
+    for (int i = 0; i < numThreads; i++)
+    {
+        ArgsGerador *a = malloc(sizeof(ArgsGerador));
+        if (!a)
+            break;
+
+        a->dados = dados;
+        a->bloco = bloco;
+        a->minimo = minimo;
+        a->maximo = maximo;
+        a->semente = (unsigned int)time(NULL) ^ (unsigned int)(getpid() << 8) ^ (unsigned int)(i * 2654435761u);
+
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, threadGerador, a) != 0)
+        {
+            free(a);
+            break;
+        }
+        pthread_detach(thread);
+        criadas++;
+    }
+
+    return criadas;
+}
+
+void escolherProximoJogo(DadosPartilhados *dados, Jogo jogos[], int numJogos)
+{
+    if (dados->numProntos > 0)
+    {
+        dados->jogoCorrente = dados->prontos[dados->inicioProntos];
+        dados->inicioProntos = (dados->inicioProntos + 1) % dados->capacidadeProntos;
+        dados->numProntos--;
+        sem_post(&dados->vagasProntos);
+    }
+    else
+    {
+        dados->jogoCorrente = jogos[rand() % numJogos];
+        dados->jogosDoCatalogo++;
+    }
+
+    dados->jogoAtual = dados->jogoCorrente.idjogo;
+}
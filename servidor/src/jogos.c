@@ -4,10 +4,152 @@
 #include <string.h>
 #include <stdlib.h>
 #include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <time.h>
+#include <stdatomic.h>
 #include "jogos.h"
+#include "protocolo.h"
+#include "motor_sudoku.h"
+#include "dificuldade.h"
+#include "verificacao.h"
 
-// Carrega jogos de um ficheiro CSV (formato: id,tabuleiro,solucao)
-int carregarJogos(const char *ficheiro, Jogo jogos[], int maxJogos)
+#define MAX_THREADS_UNICIDADE 64
+#define MAX_AVISOS_UNICIDADE 5 // Jogos problemáticos listados um a um
+
+// Resultado da verificação de unicidade de cada jogo
+enum
+{
+    JOGO_VALIDO,
+    JOGO_SEM_SOLUCAO,
+    JOGO_VARIAS_SOLUCOES,
+    JOGO_SOLUCAO_ERRADA
+};
+
+typedef struct
+{
+    const Jogo *jogos;
+    int numJogos;
+    unsigned char *estado; // Um resultado por jogo
+    atomic_int proximo;    // Próximo jogo por verificar
+} VerificacaoUnicidade;
+
+static void *threadUnicidade(void *arg)
+{
+    VerificacaoUnicidade *v = (VerificacaoUnicidade *)arg;
+    int i;
+
+    while ((i = atomic_fetch_add(&v->proximo, 1)) < v->numJogos)
+    {
+        // Contar só até 2: chega para distinguir 0, 1 e "várias"
+        const Jogo *jogo = &v->jogos[i];
+        int n, igual;
+
+        if (jogo->tamanhoBloco == 3)
+        {
+            Tabuleiro unica;
+            n = contar_solucoes(&jogo->tabuleiro, 2, &unica);
+            igual = memcmp(&unica, &jogo->solucao, sizeof(Tabuleiro)) == 0;
+        }
+        else
+        {
+            TabuleiroNxN unica;
+            n = nxn_contar_solucoes(&jogo->tabuleiroNxN, jogo->tamanhoBloco, 2, &unica, 0, NULL);
+            igual = memcmp(unica.celulas, jogo->solucaoNxN.celulas, nxn_celulas(jogo->tamanhoBloco)) == 0;
+        }
+
+        if (n == 0)
+            v->estado[i] = JOGO_SEM_SOLUCAO;
+        else if (n > 1)
+            v->estado[i] = JOGO_VARIAS_SOLUCOES;
+        else if (!igual)
+            v->estado[i] = JOGO_SOLUCAO_ERRADA;
+        else
+            v->estado[i] = JOGO_VALIDO;
+    }
+    return NULL;
+}
+
+// Verifica em paralelo (uma thread por core) que cada jogo tem uma única
+// solução e que é a guardada: verificarSolucao conta os erros contra essa
+// solução, o que só é justo se não houver outra. Em UNICIDADE_REJEITAR os
+// jogos que falham são retirados. Devolve o número de jogos que ficam.
+static int verificarUnicidade(Jogo jogos[], int numJogos, ModoUnicidade unicidade)
+{
+    if (unicidade == UNICIDADE_DESLIGADA || numJogos <= 0)
+        return numJogos;
+
+    VerificacaoUnicidade v;
+    v.jogos = jogos;
+    v.numJogos = numJogos;
+    v.estado = malloc(numJogos);
+    atomic_init(&v.proximo, 0);
+    if (!v.estado)
+    {
+        printf("Aviso: sem memória para verificar a unicidade dos jogos\n");
+        return numJogos;
+    }
+
+    int numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (numThreads < 1)
+        numThreads = 1;
+    if (numThreads > MAX_THREADS_UNICIDADE)
+        numThreads = MAX_THREADS_UNICIDADE;
+    if (numThreads > numJogos)
+        numThreads = numJogos;
+
+    struct timespec inicio, fim;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+
+    // A thread que chama também verifica
+    pthread_t threads[MAX_THREADS_UNICIDADE];
+    int criadas = 0;
+    for (int i = 1; i < numThreads; i++)
+    {
+        if (pthread_create(&threads[criadas], NULL, threadUnicidade, &v) != 0)
+            break;
+        criadas++;
+    }
+    threadUnicidade(&v);
+    for (int i = 0; i < criadas; i++)
+        pthread_join(threads[i], NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+    double segundos = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
+
+    const char *descricao[] = {"válido", "sem solução", "com várias soluções", "com solução guardada errada"};
+    int contagem[4] = {0};
+    int ficam = 0;
+    int listados = 0;
+
+    for (int i = 0; i < numJogos; i++)
+    {
+        int estado = v.estado[i];
+        contagem[estado]++;
+
+        if (estado != JOGO_VALIDO && ++listados <= MAX_AVISOS_UNICIDADE)
+        {
+            printf("DEBUG: Jogo %d %s%s\n", jogos[i].idjogo, descricao[estado],
+                   unicidade == UNICIDADE_REJEITAR ? " - rejeitado" : "");
+        }
+
+        // Compactar o array mantendo a ordem do ficheiro
+        if (estado == JOGO_VALIDO || unicidade != UNICIDADE_REJEITAR)
+            jogos[ficam++] = jogos[i];
+    }
+
+    int problemas = numJogos - contagem[JOGO_VALIDO];
+    printf("Unicidade: %d jogos verificados em %.3fs (%d threads): %d válidos, %d sem solução, %d com várias soluções, %d com solução errada%s\n",
+           numJogos, segundos, criadas + 1, contagem[JOGO_VALIDO], contagem[JOGO_SEM_SOLUCAO],
+           contagem[JOGO_VARIAS_SOLUCOES], contagem[JOGO_SOLUCAO_ERRADA],
+           problemas == 0 ? "" : unicidade == UNICIDADE_REJEITAR ? " (rejeitados)" : " (carregados na mesma)");
+
+    free(v.estado);
+    return ficam;
+}
+
+// Carrega jogos de um ficheiro CSV (formato: id,tabuleiro,solucao[,nivel,esforco])
+int carregarJogos(const char *ficheiro, Jogo jogos[], int maxJogos, ModoUnicidade unicidade)
 {
     printf("DEBUG: Tentando abrir ficheiro: '%s'\n", ficheiro);
 
@@ -26,7 +168,7 @@ int carregarJogos(const char *ficheiro, Jogo jogos[], int maxJogos)
     printf("DEBUG: Ficheiro aberto com sucesso!\n");
 
     int count = 0;
-    char linha[300]; // Buffer para cada linha do ficheiro
+    char linha[2 * NXN_MAX_CELULAS + 100]; // Buffer para cada linha do ficheiro (até 25x25)
     int linha_num = 0;
 
     // Processar cada linha do ficheiro
@@ -68,15 +210,22 @@ int carregarJogos(const char *ficheiro, Jogo jogos[], int maxJogos)
             continue;
         }
 
-        if (strlen(token) != 81)
+        // O comprimento decide o tamanho: 81 (9x9), 256 (16x16) ou 625 (25x25)
+        int bloco = nxn_bloco_de_comprimento((int)strlen(token));
+        if (!bloco)
         {
-            printf("DEBUG: Erro na linha %d - tabuleiro tem %lu chars (esperado 81)\n",
+            printf("DEBUG: Erro na linha %d - tabuleiro tem %lu chars (esperado 81, 256 ou 625)\n",
                    linha_num, strlen(token));
             continue;
         }
+        jogos[count].tamanhoBloco = bloco;
 
-        strncpy(jogos[count].tabuleiro, token, 81);
-        jogos[count].tabuleiro[81] = '\0';
+        if (bloco == 3 ? !tabuleiro_de_texto(&jogos[count].tabuleiro, token)
+                       : !nxn_de_texto(&jogos[count].tabuleiroNxN, bloco, token))
+        {
+            printf("DEBUG: Erro na linha %d - tabuleiro com caracteres inválidos\n", linha_num);
+            continue;
+        }
 
         token = strtok(NULL, ",");
         if (!token)
@@ -85,15 +234,34 @@ int carregarJogos(const char *ficheiro, Jogo jogos[], int maxJogos)
             continue;
         }
 
-        if (strlen(token) != 81)
+        if ((int)strlen(token) != nxn_celulas(bloco))
         {
-            printf("DEBUG: Erro na linha %d - solução tem %lu chars (esperado 81)\n",
-                   linha_num, strlen(token));
+            printf("DEBUG: Erro na linha %d - solução tem %lu chars (esperado %d)\n",
+                   linha_num, strlen(token), nxn_celulas(bloco));
             continue;
         }
 
-        strncpy(jogos[count].solucao, token, 81);
-        jogos[count].solucao[81] = '\0';
+        if (bloco == 3 ? !tabuleiro_de_texto(&jogos[count].solucao, token)
+                       : !nxn_de_texto(&jogos[count].solucaoNxN, bloco, token))
+        {
+            printf("DEBUG: Erro na linha %d - solução com caracteres inválidos\n", linha_num);
+            continue;
+        }
+
+        // Colunas opcionais escritas pelo sudoku-rater
+        jogos[count].dificuldade = NIVEL_NAO_CLASSIFICADO;
+        jogos[count].esforco = 0;
+        token = strtok(NULL, ",");
+        if (token)
+        {
+            int nivel = atoi(token);
+            if (nivel > NIVEL_NAO_CLASSIFICADO && nivel <= NIVEL_TENTATIVA)
+                jogos[count].dificuldade = nivel;
+
+            token = strtok(NULL, ",");
+            if (token)
+                jogos[count].esforco = atol(token);
+        }
         count++;
 
         if (count <= 3 || count == maxJogos)
@@ -103,44 +271,64 @@ int carregarJogos(const char *ficheiro, Jogo jogos[], int maxJogos)
     }
 
     fclose(f);
+
+    count = verificarUnicidade(jogos, count, unicidade);
+
     printf("\nCarregados %d jogos do ficheiro %s\n", count, ficheiro);
     return count;
 }
 
-ResultadoVerificacao verificarSolucao(const char *solucao, const char *solucaoCorreta, const char *puzzleOriginal)
+int filtrarPorTamanho(Jogo jogos[], int numJogos, int bloco)
 {
-    ResultadoVerificacao resultado = {1, 0, 0};
+    int ficam = 0;
 
-    if (strlen(solucao) != 81)
+    for (int i = 0; i < numJogos; i++)
     {
-        resultado.correto = 0;
-        resultado.numerosErrados = 81;
-        return resultado;
+        if (jogos[i].tamanhoBloco == bloco)
+            jogos[ficam++] = jogos[i];
     }
 
-    int alterouFixo = 0;
-    for (int i = 0; i < 81; i++)
+    if (ficam != numJogos)
+        printf("Tamanho: %d de %d jogos são %dx%d\n", ficam, numJogos, nxn_lado(bloco), nxn_lado(bloco));
+    return ficam;
+}
+
+int filtrarPorDificuldade(Jogo jogos[], int numJogos, int minimo, int maximo)
+{
+    int porNivel[NUM_NIVEIS_DIFICULDADE] = {0};
+    int ficam = 0;
+
+    for (int i = 0; i < numJogos; i++)
     {
-        if (puzzleOriginal[i] != '0' && solucao[i] != puzzleOriginal[i])
-        {
-            alterouFixo = 1;
-            break;
-        }
+        // O sudoku-rater só classifica 9x9: os maiores não são filtrados
+        porNivel[jogos[i].dificuldade]++;
+        if (jogos[i].tamanhoBloco != 3 ||
+            (jogos[i].dificuldade >= minimo && jogos[i].dificuldade <= maximo))
+            jogos[ficam++] = jogos[i];
     }
 
-    int valido = validarTabuleiro(solucao);
-
-    int completo = 1;
-    for (int i = 0; i < 81; i++)
+    printf("Dificuldade:");
+    const char *separador = " ";
+    for (int n = 0; n < NUM_NIVEIS_DIFICULDADE; n++)
     {
-        if (solucao[i] < '1' || solucao[i] > '9')
-        {
-            completo = 0;
-            break;
-        }
+        if (porNivel[n] == 0)
+            continue;
+        printf("%s%d %s: %d", separador, n, nome_nivel_dificuldade((NivelDificuldade)n), porNivel[n]);
+        separador = " | ";
     }
+    printf("\n");
+
+    if (ficam != numJogos)
+        printf("Dificuldade: %d de %d jogos no intervalo %d-%d\n", ficam, numJogos, minimo, maximo);
+    return ficam;
+}
 
-    if (!alterouFixo && valido && completo)
+ResultadoVerificacao verificarSolucao(const Tabuleiro *solucao, const Tabuleiro *solucaoCorreta, const Tabuleiro *puzzleOriginal)
+{
+    ResultadoVerificacao resultado = {1, 0, 0};
+
+    // Regras e pistas: a mesma verificação que o cliente faz antes de enviar
+    if (verificar_solucao_local(solucao, puzzleOriginal) == VERIFICACAO_OK)
     {
         resultado.correto = 1;
         resultado.numerosCertos = 81;
@@ -152,9 +340,9 @@ ResultadoVerificacao verificarSolucao(const char *solucao, const char *solucaoCo
     resultado.numerosCertos = 0;
     resultado.numerosErrados = 0;
 
-    for (int i = 0; i < 81; i++)
+    for (int i = 0; i < TAB_CELULAS; i++)
     {
-        if (solucao[i] == solucaoCorreta[i])
+        if (solucao->celulas[i] == solucaoCorreta->celulas[i])
         {
             resultado.numerosCertos++;
         }
@@ -167,76 +355,56 @@ ResultadoVerificacao verificarSolucao(const char *solucao, const char *solucaoCo
     return resultado;
 }
 
-int validarTabuleiro(const char *tabuleiro)
+uint32_t validarUnidades(const Tabuleiro *parcial, const Tabuleiro *solucaoCorreta, uint32_t unidades)
 {
-    int matriz[9][9];
-    stringParaMatriz(tabuleiro, matriz);
-
-    // Verificar linhas
-    for (int i = 0; i < 9; i++)
+    // Células com um valor diferente da solução: cada uma invalida a sua
+    // linha, coluna e bloco
+    uint32_t erradas = 0;
+    for (int i = 0; i < TAB_CELULAS; i++)
     {
-        int nums[10] = {0};
-        for (int j = 0; j < 9; j++)
+        if (parcial->celulas[i] != 0 && parcial->celulas[i] != solucaoCorreta->celulas[i])
         {
-            int val = matriz[i][j];
-            if (val != 0)
-            {
-                if (nums[val] > 0)
-                    return 0; // Número repetido
-                nums[val]++;
-            }
+            int linha = i / 9, coluna = i % 9;
+            erradas |= UNIDADE_BLOCO(BLOCO_DE(linha, coluna)) | UNIDADE_LINHA(linha) | UNIDADE_COLUNA(coluna);
         }
     }
 
-    // Verificar colunas
-    for (int j = 0; j < 9; j++)
+    return unidades & TODAS_UNIDADES & ~erradas;
+}
+
+ResultadoVerificacao verificarSolucaoNxN(const TabuleiroNxN *solucao, const TabuleiroNxN *solucaoCorreta,
+                                         const TabuleiroNxN *puzzleOriginal, int bloco)
+{
+    ResultadoVerificacao resultado = {1, 0, 0};
+    int celulas = nxn_celulas(bloco);
+
+    // Mesma regra do 9x9 (e a mesma verificação que o cliente faz antes de
+    // enviar): certo se completo, válido e sem pistas alteradas; senão conta
+    // erros contra a solução guardada
+    if (verificar_solucao_local_nxn(solucao, puzzleOriginal, bloco) == VERIFICACAO_OK)
     {
-        int nums[10] = {0};
-        for (int i = 0; i < 9; i++)
-        {
-            int val = matriz[i][j];
-            if (val != 0)
-            {
-                if (nums[val] > 0)
-                    return 0;
-                nums[val]++;
-            }
-        }
+        resultado.numerosCertos = celulas;
+        return resultado;
     }
 
-    // Verificar regiões 3x3
-    for (int regiao = 0; regiao < 9; regiao++)
+    resultado.correto = 0;
+    for (int i = 0; i < celulas; i++)
     {
-        int nums[10] = {0};
-        int startRow = (regiao / 3) * 3;
-        int startCol = (regiao % 3) * 3;
-
-        for (int i = startRow; i < startRow + 3; i++)
-        {
-            for (int j = startCol; j < startCol + 3; j++)
-            {
-                int val = matriz[i][j];
-                if (val != 0)
-                {
-                    if (nums[val] > 0)
-                        return 0;
-                    nums[val]++;
-                }
-            }
-        }
+        if (solucao->celulas[i] == solucaoCorreta->celulas[i])
+            resultado.numerosCertos++;
+        else
+            resultado.numerosErrados++;
     }
-
-    return 1; // Tabuleiro válido
+    return resultado;
 }
 
-void imprimirTabuleiro(const char *tabuleiro)
+void imprimirTabuleiro(const Tabuleiro *tabuleiro)
 {
     for (int i = 0; i < 9; i++)
     {
         for (int j = 0; j < 9; j++)
         {
-            int idx = i * 9 + j;
-            printf("%c ", tabuleiro[idx]);
+            printf("%c ", '0' + TAB_CELULA(tabuleiro, i, j));
             if (j == 2 || j == 5)
                 printf("| ");
         }
@@ -247,28 +415,3 @@ void imprimirTabuleiro(const char *tabuleiro)
         }
     }
 }
-
-void stringParaMatriz(const char *str, int matriz[9][9])
-{
-    for (int i = 0; i < 9; i++)
-    {
-        for (int j = 0; j < 9; j++)
-        {
-            int idx = i * 9 + j;
-            matriz[i][j] = str[idx] - '0';
-        }
-    }
-}
-
-void matrizParaString(int matriz[9][9], char *str)
-{
-    for (int i = 0; i < 9; i++)
-    {
-        for (int j = 0; j < 9; j++)
-        {
-            int idx = i * 9 + j;
-            str[idx] = matriz[i][j] + '0';
-        }
-    }
-    str[81] = '\0';
-}
\ No newline at end of file
@@ -156,6 +156,8 @@ const char *obterDescricaoEvento(CodigoEvento evento)
         return "Bloco NOK";
     case EVT_JOGO_PERDIDO:
         return "Jogo Perdido";
+    case EVT_VALIDACAO_TABULEIRO:
+        return "Validacao Tabuleiro";
     case EVT_ERRO_GERAL:
         return "Erro Geral";
     default:
@@ -19,6 +19,7 @@
 #include "protocolo.h"
 #include "util.h"
 #include "servidor.h"
+#include "gerador.h"
 
 #define CONFIG_DIR "config/servidor"
 #define MAX_CONFIGS 50
@@ -57,15 +58,15 @@ void *lobby_timer_thread(void *arg)
 
             if (tempo_decorrido >= config_global.tempoAgregacao)
             {
-                printf("\n\033[32mJogo #%d iniciado - %d jogadores\033[0m\n",
-                       dados_global->jogoAtual, dados_global->numClientesLobby);
-
-                dados_global->jogoAtual = rand() % numJogos_global;
+                escolherProximoJogo(dados_global, jogos_global, numJogos_global);
                 dados_global->jogoIniciado = 1;
                 dados_global->jogoTerminado = 0;
                 dados_global->idVencedor = -1;
                 dados_global->tempoVitoria = 0;
 
+                printf("\n\033[32mJogo #%d iniciado - %d jogadores\033[0m\n",
+                       dados_global->jogoAtual, dados_global->numClientesLobby);
+
                 char log_msg[256];
                 snprintf(log_msg, sizeof(log_msg),
                          "Jogo #%d iniciado por timeout - %d jogadores",
@@ -106,6 +107,7 @@ void cleanup_servidor(void)
     {
         sem_destroy(&dados_global->mutex);
         sem_destroy(&dados_global->lobby_semaforo);
+        sem_destroy(&dados_global->vagasProntos);
         munmap(dados_global, sizeof(DadosPartilhados));
         dados_global = NULL;
     }
@@ -411,7 +413,11 @@ int main(int argc, char *argv[])
         err_dump("Servidor: Falha ao alocar memória para jogos");
     }
 
-    numJogos = carregarJogos(config.ficheiroJogos, jogos, config.maxJogos);
+    numJogos = carregarJogos(config.ficheiroJogos, jogos, config.maxJogos, config.unicidade);
+    if (numJogos > 0)
+        numJogos = filtrarPorTamanho(jogos, numJogos, config.tamanhoBloco);
+    if (numJogos > 0)
+        numJogos = filtrarPorDificuldade(jogos, numJogos, config.dificuldadeMin, config.dificuldadeMax);
     if (numJogos <= 0)
     {
         registarEvento(0, EVT_ERRO_GERAL, "Nenhum jogo carregado, servidor a fechar.");
@@ -448,10 +454,25 @@ int main(int argc, char *argv[])
     dados->idVencedor = -1;        // Sem vencedor ainda
     dados->tempoVitoria = 0;       // Sem timestamp de vitória
 
+    // Pool de jogos gerados: vazio, enche-se em segundo plano
+    if (config.geradores < 0)
+        config.geradores = 0;
+    if (config.poolGerados < 1)
+        config.poolGerados = 1;
+    if (config.poolGerados > MAX_JOGOS_PRONTOS)
+        config.poolGerados = MAX_JOGOS_PRONTOS;
+    dados->inicioProntos = 0;
+    dados->numProntos = 0;
+    dados->capacidadeProntos = config.poolGerados;
+    dados->proximoIdGerado = ID_PRIMEIRO_JOGO_GERADO;
+    dados->jogosGerados = 0;
+    dados->jogosDoCatalogo = 0;
+
     // Inicializa semáforos
     // O '1' no meio significa "partilhado entre processos"
     sem_init(&dados->mutex, 1, 1);          // Mutex começa a 1 (livre)
     sem_init(&dados->lobby_semaforo, 1, 0); // Semáforo do lobby começa a 0 (bloqueado)
+    sem_init(&dados->vagasProntos, 1, config.poolGerados); // Pool começa todo livre
 
     /* Cria socket stream (TCP) para Internet */
     printf("6. A criar socket TCP (AF_INET)...\n");
@@ -485,6 +506,17 @@ int main(int argc, char *argv[])
     }
     pthread_detach(timer_thread);
 
+    // Geradores: threads do processo pai (os filhos do fork não as herdam)
+    if (config.geradores > 0)
+    {
+        int geradores = iniciarGeradores(dados, config.geradores, config.tamanhoBloco,
+                                         config.dificuldadeMin, config.dificuldadeMax);
+        snprintf(log_init, sizeof(log_init),
+                 "%d threads a gerar jogos (pool de %d)", geradores, config.poolGerados);
+        registarEvento(0, EVT_SERVIDOR_INICIADO, log_init);
+        printf("Gerador: %s\n", log_init);
+    }
+
     printf("\n\033[1;36m");
     printf("╔══════════════════════════════════════╗\n");
     printf("║   SERVIDOR SUDOKU MULTIPLAYER       ║\n");
@@ -0,0 +1,171 @@
+// servidor/src/main_classificador.c - Classificação offline do catálogo de jogos
+//
+// Uso: sudoku-rater [-o saida.txt] [-v] [ficheiro]
+//
+// Lê o catálogo no formato de jogos.txt (id,tabuleiro,solucao) e acrescenta
+// a cada jogo a dificuldade (técnica mais difícil necessária) e o esforço
+// de pesquisa:
+//   id,tabuleiro,solucao,nivel,esforco
+// Colunas de uma classificação anterior são substituídas e os fins de
+// linha mantidos. Sem -o o ficheiro de entrada é reescrito (via ficheiro
+// temporário + rename).
+// Linhas mal formadas são copiadas sem alterações.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "dificuldade.h"
+#include "tabuleiro.h"
+
+#define MAX_LINHA 512
+#define FICHEIRO_JOGOS_OMISSAO "servidor/data/jogos.txt"
+
+typedef struct
+{
+    long jogos;
+    long mal_formados;
+    long sem_solucao;
+    long por_nivel[NUM_NIVEIS_DIFICULDADE];
+    long nos_por_nivel[NUM_NIVEIS_DIFICULDADE];
+} Resumo;
+
+// Classifica uma linha e escreve-a na saída. Devolve 0 se estiver mal formada.
+static int classificar_linha(char *linha, const char *fim, FILE *saida, Resumo *r, int verboso)
+{
+    char copia[MAX_LINHA];
+    snprintf(copia, sizeof(copia), "%s", linha);
+
+    char *id = strtok(linha, ",");
+    char *texto = strtok(NULL, ",");
+    char *solucao = strtok(NULL, ",");
+    Tabuleiro puzzle;
+
+    if (!id || !texto || !solucao || strlen(texto) != 81 || strlen(solucao) != 81 ||
+        !tabuleiro_de_texto(&puzzle, texto))
+    {
+        fprintf(saida, "%s%s", copia, fim);
+        return 0;
+    }
+
+    Classificacao c;
+    if (!classificar_puzzle(&puzzle, &c))
+    {
+        r->sem_solucao++;
+        fprintf(stderr, "[RATER] Jogo %s: pistas contraditórias ou sem solução\n", id);
+    }
+
+    r->jogos++;
+    r->por_nivel[c.nivel]++;
+    r->nos_por_nivel[c.nivel] += c.nos;
+
+    if (verboso)
+        fprintf(stderr, "[RATER] Jogo %s: nível %d (%s), %ld nós, %d células por lógica\n",
+                id, c.nivel, nome_nivel_dificuldade(c.nivel), c.nos, c.preenchidas_logica);
+
+    fprintf(saida, "%s,%s,%s,%d,%ld%s", id, texto, solucao, c.nivel, c.nos, fim);
+    return 1;
+}
+
+static void uso(const char *programa)
+{
+    fprintf(stderr, "Uso: %s [-o saida.txt] [-v] [ficheiro]\n", programa);
+    fprintf(stderr, "  -o  Ficheiro de saída (por omissão: reescreve o ficheiro de entrada)\n");
+    fprintf(stderr, "  -v  Mostra a classificação de cada jogo\n");
+    fprintf(stderr, "  ficheiro  Catálogo id,tabuleiro,solucao (por omissão: %s)\n", FICHEIRO_JOGOS_OMISSAO);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *ficheiro_saida = NULL;
+    int verboso = 0;
+    int opcao;
+
+    while ((opcao = getopt(argc, argv, "o:vh")) != -1)
+    {
+        switch (opcao)
+        {
+        case 'o':
+            ficheiro_saida = optarg;
+            break;
+        case 'v':
+            verboso = 1;
+            break;
+        default:
+            uso(argv[0]);
+            return 1;
+        }
+    }
+
+    const char *ficheiro = optind < argc ? argv[optind] : FICHEIRO_JOGOS_OMISSAO;
+
+    FILE *entrada = fopen(ficheiro, "r");
+    if (!entrada)
+    {
+        perror("Erro ao abrir ficheiro de jogos");
+        return 1;
+    }
+
+    // Reescrever no próprio ficheiro: escrever ao lado e trocar no fim
+    char temporario[300];
+    const char *destino = ficheiro_saida ? ficheiro_saida : ficheiro;
+    snprintf(temporario, sizeof(temporario), "%s.tmp", destino);
+
+    FILE *saida = fopen(ficheiro_saida ? ficheiro_saida : temporario, "w");
+    if (!saida)
+    {
+        perror("Erro ao criar ficheiro de saída");
+        fclose(entrada);
+        return 1;
+    }
+
+    Resumo r;
+    memset(&r, 0, sizeof(r));
+
+    struct timespec inicio, fim;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+
+    // Manter os fins de linha do ficheiro original (jogos.txt usa CRLF)
+    const char *fim_linha = NULL;
+    char linha[MAX_LINHA];
+    while (fgets(linha, sizeof(linha), entrada))
+    {
+        if (!fim_linha)
+            fim_linha = strchr(linha, '\r') ? "\r\n" : "\n";
+        linha[strcspn(linha, "\r\n")] = 0;
+        if (linha[0] == 0)
+            continue;
+        if (!classificar_linha(linha, fim_linha, saida, &r, verboso))
+            r.mal_formados++;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+    double segundos = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
+
+    fclose(entrada);
+    if (fclose(saida) != 0)
+    {
+        perror("Erro ao escrever ficheiro de saída");
+        return 1;
+    }
+    if (!ficheiro_saida && rename(temporario, ficheiro) != 0)
+    {
+        perror("Erro ao substituir ficheiro de jogos");
+        return 1;
+    }
+
+    fprintf(stderr, "[RATER] %ld jogos classificados em %.3fs -> %s\n", r.jogos, segundos, destino);
+    for (int n = 1; n < NUM_NIVEIS_DIFICULDADE; n++)
+    {
+        if (r.por_nivel[n] == 0)
+            continue;
+        fprintf(stderr, "[RATER]   %d %-22s %4ld jogos | esforço médio %ld nós\n",
+                n, nome_nivel_dificuldade((NivelDificuldade)n), r.por_nivel[n],
+                r.nos_por_nivel[n] / r.por_nivel[n]);
+    }
+    if (r.sem_solucao || r.mal_formados)
+        fprintf(stderr, "[RATER] Sem solução: %ld | Mal formados: %ld\n", r.sem_solucao, r.mal_formados);
+
+    return (r.sem_solucao || r.mal_formados) ? 2 : 0;
+}
@@ -11,6 +11,7 @@
 #include "jogos.h"
 #include "logs.h"
 #include "servidor.h"
+#include "gerador.h"
 
 void str_echo(int sockfd, Jogo jogos[], int numJogos, DadosPartilhados *dados, int maxLinha, int timeoutCliente)
 {
@@ -19,7 +20,7 @@ void str_echo(int sockfd, Jogo jogos[], int numJogos, DadosPartilhados *dados, i
     int n;
     MensagemSudoku msg_recebida;
     MensagemSudoku msg_resposta;
-    int meu_jogo = -1;
+    Jogo meu_jogo; // Cópia local: o jogoCorrente muda na ronda seguinte
 
     // FASE 1: Controlo de capacidade
     sem_wait(&dados->mutex);
@@ -73,7 +74,7 @@ void str_echo(int sockfd, Jogo jogos[], int numJogos, DadosPartilhados *dados, i
 
         if (dados->numClientesLobby >= 10)
         {
-            dados->jogoAtual = rand() % numJogos;
+            escolherProximoJogo(dados, jogos, numJogos);
             dados->jogoIniciado = 1;
             dados->jogoTerminado = 0;
             dados->idVencedor = -1;
@@ -101,21 +102,31 @@ void str_echo(int sockfd, Jogo jogos[], int numJogos, DadosPartilhados *dados, i
 
         // FASE 4: Enviar jogo
         sem_wait(&dados->mutex);
-        meu_jogo = dados->jogoAtual;
+        meu_jogo = dados->jogoCorrente;
         dados->numClientesLobby--;
         dados->numJogadoresAtivos++;
         sem_post(&dados->mutex);
 
         bzero(&msg_resposta, sizeof(MensagemSudoku));
         msg_resposta.tipo = ENVIAR_JOGO;
-        msg_resposta.idJogo = jogos[meu_jogo].idjogo;
-        strncpy(msg_resposta.tabuleiro, jogos[meu_jogo].tabuleiro, sizeof(msg_resposta.tabuleiro) - 1);
+        msg_resposta.idJogo = meu_jogo.idjogo;
+        msg_resposta.tamanhoBloco = meu_jogo.tamanhoBloco;
+        if (meu_jogo.tamanhoBloco == 3)
+            tabuleiro_compactar(&meu_jogo.tabuleiro, &msg_resposta.tabuleiro);
 
         if (writen(sockfd, (char *)&msg_resposta, sizeof(MensagemSudoku)) != sizeof(MensagemSudoku))
         {
             goto cleanup_e_sair;
         }
 
+        // 16x16 e 25x25: o tabuleiro segue a mensagem (um byte por célula)
+        int celulas = nxn_celulas(meu_jogo.tamanhoBloco);
+        if (meu_jogo.tamanhoBloco != 3 &&
+            writen(sockfd, (char *)meu_jogo.tabuleiroNxN.celulas, celulas) != celulas)
+        {
+            goto cleanup_e_sair;
+        }
+
         registarEvento(msg_recebida.idCliente, EVT_JOGO_ENVIADO, "Jogo enviado ao cliente");
 
         // FASE 5: Configurar timeout
@@ -139,7 +150,7 @@ void str_echo(int sockfd, Jogo jogos[], int numJogos, DadosPartilhados *dados, i
                 bzero(&msg_resposta, sizeof(MensagemSudoku));
                 msg_resposta.tipo = JOGO_TERMINADO;
                 msg_resposta.idCliente = vencedor; // Quem ganhou
-                msg_resposta.idJogo = meu_jogo;
+                msg_resposta.idJogo = meu_jogo.idjogo;
                 snprintf(msg_resposta.resposta, sizeof(msg_resposta.resposta),
                          "Cliente %d ganhou primeiro!", vencedor);
                 writen(sockfd, (char *)&msg_resposta, sizeof(MensagemSudoku));
@@ -186,19 +197,35 @@ void str_echo(int sockfd, Jogo jogos[], int numJogos, DadosPartilhados *dados, i
                 snprintf(log_msg, sizeof(log_msg), "Pedido de validação para Bloco %d", msg_recebida.bloco_id);
                 registarEvento(msg_recebida.idCliente, EVT_VALIDACAO_BLOCO, log_msg);
 
-                int bloco_correto = 1;
-                int start_row = (msg_recebida.bloco_id / 3) * 3;
-                int start_col = (msg_recebida.bloco_id % 3) * 3;
-                const char *solucao = jogos[meu_jogo].solucao;
+                // Blocos de tamanho b×b numa grelha de lado b²; em 16x16 e
+                // 25x25 o conteúdo do bloco segue a mensagem
+                int tamanho = meu_jogo.tamanhoBloco;
+                int lado = nxn_lado(tamanho);
+                uint8_t conteudo[NXN_MAX_LADO];
+
+                if (tamanho == 3)
+                {
+                    for (int k = 0; k < 9; k++)
+                        conteudo[k] = (uint8_t)msg_recebida.conteudo_bloco[k];
+                }
+                else if (readn(sockfd, (char *)conteudo, lado) != lado)
+                {
+                    goto cleanup_e_sair;
+                }
+
+                int bloco_correto = msg_recebida.bloco_id >= 0 && msg_recebida.bloco_id < lado;
+                int start_row = (msg_recebida.bloco_id / tamanho) * tamanho;
+                int start_col = (msg_recebida.bloco_id % tamanho) * tamanho;
+                const uint8_t *solucao = tamanho == 3 ? meu_jogo.solucao.celulas : meu_jogo.solucaoNxN.celulas;
 
                 int k = 0;
-                for (int r = 0; r < 3; r++)
+                for (int r = 0; r < tamanho && bloco_correto; r++)
                 {
-                    for (int c = 0; c < 3; c++)
+                    for (int c = 0; c < tamanho; c++)
                     {
-                        int idx = (start_row + r) * 9 + (start_col + c);
-                        int val_solucao = solucao[idx] - '0';
-                        int val_cliente = msg_recebida.conteudo_bloco[k++];
+                        int idx = (start_row + r) * lado + (start_col + c);
+                        int val_solucao = solucao[idx];
+                        int val_cliente = conteudo[k++];
 
                         if (val_cliente != 0 && val_cliente != val_solucao)
                         {
@@ -210,7 +237,7 @@ void str_echo(int sockfd, Jogo jogos[], int numJogos, DadosPartilhados *dados, i
                 bzero(&msg_resposta, sizeof(MensagemSudoku));
                 msg_resposta.tipo = RESPOSTA_BLOCO;
                 msg_resposta.idCliente = msg_recebida.idCliente;
-                msg_resposta.idJogo = meu_jogo;
+                msg_resposta.idJogo = meu_jogo.idjogo;
                 msg_resposta.bloco_id = msg_recebida.bloco_id;
 
                 if (bloco_correto)
@@ -232,6 +259,43 @@ void str_echo(int sockfd, Jogo jogos[], int numJogos, DadosPartilhados *dados, i
                 continue;
             }
 
+            // Validação de várias unidades (blocos, linhas e colunas) num só pedido
+            if (msg_recebida.tipo == VALIDAR_TABULEIRO)
+            {
+                time_t now = time(NULL);
+                struct tm *t = localtime(&now);
+                uint32_t pedidas = msg_recebida.unidades & TODAS_UNIDADES;
+
+                printf("\x1b[34m[%02d:%02d:%02d] [%d] [REDE]  Recebido pedido VALIDAR_TABULEIRO (%d unidades)\x1b[0m\n",
+                       t->tm_hour, t->tm_min, t->tm_sec,
+                       msg_recebida.idCliente, __builtin_popcount(pedidas));
+
+                // Só 9x9: em 16x16 e 25x25 as unidades não cabem na máscara
+                uint32_t veredicto = 0;
+                if (meu_jogo.tamanhoBloco == 3)
+                {
+                    Tabuleiro parcial;
+                    tabuleiro_descompactar(&msg_recebida.tabuleiro, &parcial);
+                    veredicto = validarUnidades(&parcial, &meu_jogo.solucao, pedidas);
+                }
+
+                bzero(&msg_resposta, sizeof(MensagemSudoku));
+                msg_resposta.tipo = RESPOSTA_TABULEIRO;
+                msg_resposta.idCliente = msg_recebida.idCliente;
+                msg_resposta.idJogo = meu_jogo.idjogo;
+                msg_resposta.unidades = pedidas;
+                msg_resposta.veredicto = veredicto;
+                strcpy(msg_resposta.resposta, veredicto == pedidas ? "OK" : "NOK");
+
+                char log_msg[128];
+                snprintf(log_msg, sizeof(log_msg), "Validação de %d unidades: %d corretas",
+                         __builtin_popcount(pedidas), __builtin_popcount(veredicto));
+                registarEvento(msg_recebida.idCliente, EVT_VALIDACAO_TABULEIRO, log_msg);
+
+                writen(sockfd, (char *)&msg_resposta, sizeof(MensagemSudoku));
+                continue;
+            }
+
             if (msg_recebida.tipo == ENVIAR_SOLUCAO)
             {
                 aguardando_solucao = 0;
@@ -246,7 +310,22 @@ void str_echo(int sockfd, Jogo jogos[], int numJogos, DadosPartilhados *dados, i
         snprintf(log_solucao, sizeof(log_solucao), "Solução recebida do Cliente %d (A verificar...)", msg_recebida.idCliente);
         registarEvento(msg_recebida.idCliente, EVT_SOLUCAO_RECEBIDA, log_solucao);
 
-        ResultadoVerificacao resultado = verificarSolucao(msg_recebida.tabuleiro, jogos[meu_jogo].solucao, jogos[meu_jogo].tabuleiro);
+        ResultadoVerificacao resultado;
+        if (meu_jogo.tamanhoBloco == 3)
+        {
+            Tabuleiro solucao_cliente;
+            tabuleiro_descompactar(&msg_recebida.tabuleiro, &solucao_cliente);
+            resultado = verificarSolucao(&solucao_cliente, &meu_jogo.solucao, &meu_jogo.tabuleiro);
+        }
+        else
+        {
+            TabuleiroNxN solucao_cliente;
+            int celulas = nxn_celulas(meu_jogo.tamanhoBloco);
+            if (readn(sockfd, (char *)solucao_cliente.celulas, celulas) != celulas)
+                goto cleanup_e_sair;
+            resultado = verificarSolucaoNxN(&solucao_cliente, &meu_jogo.solucaoNxN,
+                                            &meu_jogo.tabuleiroNxN, meu_jogo.tamanhoBloco);
+        }
 
         bzero(&msg_resposta, sizeof(MensagemSudoku));
         msg_resposta.tipo = RESPOSTA_SOLUCAO;